@@ -7,7 +7,9 @@
 #include <sdl/textureatlas.h>
 #include <sdl/window.h>
 #include <sdl/shader.h>
+#include <sdl/shaderpermutations.h>
 #include <sdl/graphic.h>
+#include <sdl/colorpipeline.h>
 
 
 class GraphicWindow : public sdl::Window {
@@ -31,7 +33,7 @@ private:
 	void initPreLoop() override {
 		sprite_ = textureAtlas_.add("tetris.bmp");
 		resize(sdl::Window::getWidth(), sdl::Window::getHeight());
-		shader_ = sdl::Shader::CreateShaderGlsl_330();
+		shaders_.preload({sdl::ShaderFeatures::VertexColor, sdl::ShaderFeatures::VertexColor | sdl::ShaderFeatures::Textured});
 
 		graphic_.addRectangle({0.1f, 0.4f}, {0.2f, 0.2f}, sdl::color::White);
 		graphic_.addRectangle({-0.1f, -0.4f}, {0.2f, 0.2f}, sdl::color::Red);
@@ -58,10 +60,10 @@ private:
 
 	void update(const sdl::DeltaTime& deltaTime) override {
 		sdl::GlEnableScoped scoped{gl::GL_BLEND, gl::GL_LINE_SMOOTH};
-		gl::glBlendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+		sdl::colorpipeline::apply();
 
 		sprite_.bind();
-		graphic_.upload(shader_);
+		graphic_.upload(shaders_);
 	}
 
 	void eventUpdate(const SDL_Event& windowEvent) override {
@@ -107,20 +109,34 @@ private:
 					case SDLK_c:
 						graphic_.clear();
 						break;
+					case SDLK_a:
+						addLateImage();
+						break;
 				}
 				break;
 		}
 
 	}
 
+	// Insert into the atlas after its texture exists, i.e. the mipmaps must be regenerated
+	// for the new image to be drawn through Graphic.
+	void addLateImage() {
+		const auto& sprite = textureAtlas_.add(sdl::Surface{64, 64, sdl::color::html::Tomato}, 4);
+		if (sprite.isValid()) {
+			float x = -0.9f + 0.1f * static_cast<float>(lateImages_++ % 18);
+			graphic_.addRectangleImage({x, -0.9f}, {0.08f, 0.08f}, sprite.getTextureView());
+		}
+	}
+
 	void resize(int w, int h) {
 		gl::glViewport(0, 0, w, h);
 	}
 
-	sdl::Shader shader_;
+	sdl::ShaderPermutations shaders_;
 	sdl::Graphic graphic_;
 	sdl::Sprite sprite_;
-	sdl::TextureAtlas textureAtlas_{2048, 2048};
+	sdl::TextureAtlas textureAtlas_{2048, 2048, sdl::mipmapFilter(16.f)};
+	int lateImages_ = 0;
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include <sdl/sprite.h>
 #include <sdl/sound.h>
 #include <sdl/textureatlas.h>
+#include <sdl/colorspan.h>
 #include <sdl/initsdl.h>
 
 #include <spdlog/spdlog.h>
@@ -15,6 +16,7 @@
 #include <fmt/core.h>
 
 #include <cassert>
+#include <chrono>
 #include <sstream>
 
 using namespace sdl::color;
@@ -116,6 +118,58 @@ void testGraphicWindow() {
 	}
 }
 
+// Render a fixed number of frames without showing the window, and capture a few of them.
+void testHeadlessWindow() {
+	GraphicWindow w{3, 3};
+	w.setHeadless(300);
+	w.setHeadlessCapture("headless", 100);
+	w.startLoop();
+
+	const auto& times = w.getHeadlessFrameTimes();
+	fmt::println("Frames: {}, mean: {:.3f} ms, p99: {:.3f} ms", times.getSize(), times.getMean(), times.getPercentile(99));
+}
+
+// Compare the bulk color operations with the scalar operators.
+void testColorBenchmark() {
+	constexpr int Size = 1'000'000;
+	constexpr int Iterations = 20;
+	std::vector<sdl::Color> colors(Size, sdl::Color::createU32(10, 120, 250, 200));
+	std::vector<glm::vec4> floats(Size);
+	const auto tint = sdl::Color::createU32(255, 128, 64, 255);
+
+	auto measure = [&](std::string_view name, auto&& function) {
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < Iterations; ++i) {
+			function();
+		}
+		const auto time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start) / Iterations;
+		fmt::println("{:<24} {:8.3f} ms", name, time.count());
+	};
+
+	measure("operator*=", [&] {
+		for (auto& color : colors) {
+			color *= tint;
+		}
+	});
+	measure("color::multiply", [&] {
+		sdl::color::multiply(colors, tint);
+	});
+	measure("Color::red() etc", [&] {
+		for (int i = 0; i < Size; ++i) {
+			floats[i] = {colors[i].red(), colors[i].green(), colors[i].blue(), colors[i].alpha()};
+		}
+	});
+	measure("color::convertToFloat4", [&] {
+		sdl::color::convertToFloat4(colors, floats);
+	});
+	measure("color::premultiplyAlpha", [&] {
+		sdl::color::premultiplyAlpha(colors);
+	});
+	measure("color::srgbToLinear", [&] {
+		sdl::color::srgbToLinear(colors, floats);
+	});
+}
+
 void testImGuiWindow() {
 	TestImGuiWindow w;
 	w.startLoop();
@@ -127,6 +181,9 @@ void showHelp(const std::string& programName) {
 	fmt::println("\t{} -2 ", programName);
 	fmt::println("\t{} -3 ", programName);
 	fmt::println("\t{} -4 ", programName);
+	fmt::println("\t{} -5 ", programName);
+	fmt::println("\t{} -6 ", programName);
+	fmt::println("\t{} -7 ", programName);
 	fmt::println("");
 	fmt::println("Options:");
 	fmt::println("\t-h --help                show this help");
@@ -135,6 +192,8 @@ void showHelp(const std::string& programName) {
 	fmt::println("\t-3                       testLoadTextureAtlas2");
 	fmt::println("\t-4                       testBatchWindow");
 	fmt::println("\t-5                       testImGuiWindow");
+	fmt::println("\t-6                       testHeadlessWindow");
+	fmt::println("\t-7                       testColorBenchmark");
 }
 
 void runAll() {
@@ -195,6 +254,12 @@ int main(int argc, char** argv) {
 		} else if (code == "-5") {
 			testImGuiWindow();
 			return 0;
+		} else if (code == "-6") {
+			testHeadlessWindow();
+			return 0;
+		} else if (code == "-7") {
+			testColorBenchmark();
+			return 0;
 		} else {
 			fmt::println("Incorrect argument {}", code);
 		}
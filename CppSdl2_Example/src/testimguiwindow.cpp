@@ -1,5 +1,6 @@
 #include "testimguiwindow.h"
 
+#include <sdl/glstate.h>
 #include <sdl/imguiauxiliary.h>
 
 #include <spdlog/spdlog.h>
@@ -58,11 +59,11 @@ void TestImGuiWindow::imGuiUpdate(const sdl::DeltaTime& deltaTime) {
 }
 
 void TestImGuiWindow::imGuiPreUpdate(const sdl::DeltaTime& deltaTime) {
-	gl::glEnable(gl::GL_BLEND);
+	sdl::glstate::setEnabled(gl::GL_BLEND, true);
 	gl::glBlendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
 	batch_->draw();
 	batchIndexes_->draw();
-	gl::glDisable(gl::GL_BLEND);
+	sdl::glstate::setEnabled(gl::GL_BLEND, false);
 }
 
 void TestImGuiWindow::initPreLoop() {
@@ -15,8 +15,8 @@ TestShader::TestShader(const std::string& vShader, const std::string& fShader) {
 		aColorIndex_ = shader_.getAttributeLocation("aColor");
 		aTextureIndex_ = shader_.getAttributeLocation("aTexture");
 		
-		uProjIndex_ = shader_.getUniformLocation("uProj");
-		uModelIndex_ = shader_.getUniformLocation("uModel");
+		updateUniformLocations();
+		shader_.setHotReload(true);
 	}
 }
 
@@ -24,6 +24,18 @@ void TestShader::useProgram() {
 	shader_.useProgram();
 }
 
+void TestShader::reloadIfChanged() {
+	// The attributes are bound, i.e. only the uniform locations may change.
+	if (shader_.reloadIfChanged()) {
+		updateUniformLocations();
+	}
+}
+
+void TestShader::updateUniformLocations() {
+	uProjIndex_ = shader_.getUniformLocation("uProj");
+	uModelIndex_ = shader_.getUniformLocation("uModel");
+}
+
 void TestShader::setVertexAttribPointer() const {
 	size_t size = 0;
 
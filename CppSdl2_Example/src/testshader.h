@@ -15,6 +15,9 @@ public:
 	TestShader(const std::string& vShader, const std::string& fShader);
 
 	void useProgram();
+
+	// Recompile if the shader files are edited.
+	void reloadIfChanged();
 	void setVertexAttribPointer() const;
 
 	void setProjectionMatrix(const Mat44& matrix);
@@ -41,6 +44,8 @@ public:
 	};
 
 private:
+	void updateUniformLocations();
+
 	sdl::ShaderProgram shader_;
 
 	int aPosIndex_ = -1;
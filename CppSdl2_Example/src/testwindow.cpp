@@ -6,6 +6,7 @@
 #include <sdl/sprite.h>
 #include <sdl/gamecontroller.h>
 #include <sdl/framebuffer.h>
+#include <sdl/glstate.h>
 
 #include <fmt/core.h>
 
@@ -76,9 +77,11 @@ TestWindow::TestWindow(const sdl::Sprite& sprite)
 }
 
 void TestWindow::update(const sdl::DeltaTime& deltaTime) {
-	gl::glEnable(gl::GL_BLEND);
+	sdl::glstate::setEnabled(gl::GL_BLEND, true);
 	gl::glBlendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
 
+	shader_->reloadIfChanged();
+
 	// Update model matrix.
 	shader_->useProgram();
 	sprite_.bind();
@@ -89,7 +92,7 @@ void TestWindow::update(const sdl::DeltaTime& deltaTime) {
 	text_.bind();
 	batch2_->draw();
 
-	gl::glDisable(gl::GL_BLEND);
+	sdl::glstate::setEnabled(gl::GL_BLEND, false);
 }
 
 void TestWindow::eventUpdate(const SDL_Event& windowEvent) {
@@ -1,5 +1,16 @@
+#include <sdl/colorspan.h>
+#include <sdl/compressedimage.h>
+
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
 class Test : public ::testing::Test {
 protected:
 
@@ -20,3 +31,217 @@ TEST_F(Test, someTest) {
 	EXPECT_TRUE(true);
 	EXPECT_EQ(0, 0);
 }
+
+namespace {
+
+	// A KTX2 file with a single BC1 (vkFormat 131) level.
+	std::vector<std::uint8_t> createKtx2(std::uint32_t width, std::uint32_t height, std::uint64_t offset, std::size_t dataSize) {
+		std::vector<std::uint8_t> data(80 + 24 + dataSize);
+		const std::uint8_t identifier[]{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+		std::memcpy(data.data(), identifier, sizeof(identifier));
+		auto write = [&](std::size_t position, auto value) {
+			std::memcpy(data.data() + position, &value, sizeof(value));
+		};
+		write(12, std::uint32_t{131});
+		write(20, width);
+		write(24, height);
+		write(36, std::uint32_t{1});
+		write(40, std::uint32_t{1});
+		write(80, offset);
+		write(88, std::uint64_t{(width + 3) / 4 * ((height + 3) / 4) * 8});
+		return data;
+	}
+
+	// Not a multiple of the SIMD width, in order to test the scalar tail.
+	std::vector<sdl::Color> createColors(int size, int offset = 0) {
+		std::vector<sdl::Color> colors;
+		for (int i = offset; i < size + offset; ++i) {
+			colors.push_back(sdl::Color::createU32(static_cast<uint8_t>(i * 7), static_cast<uint8_t>(i * 13), static_cast<uint8_t>(i * 29), static_cast<uint8_t>(i * 31)));
+		}
+		return colors;
+	}
+
+}
+
+TEST_F(Test, colorMultiplyEqualsScalarOperator) {
+	// Given.
+	const auto colors = createColors(103);
+	const auto tint = sdl::Color::createU32(200, 17, 255, 128);
+
+	// When.
+	auto result = colors;
+	sdl::color::multiply(result, tint);
+
+	// Then.
+	for (std::size_t i = 0; i < colors.size(); ++i) {
+		EXPECT_EQ(colors[i] * tint, result[i]);
+	}
+}
+
+TEST_F(Test, colorPremultiplyAlpha) {
+	// Given.
+	const auto colors = createColors(103);
+
+	// When.
+	auto result = colors;
+	sdl::color::premultiplyAlpha(result);
+
+	// Then.
+	for (std::size_t i = 0; i < colors.size(); ++i) {
+		auto alpha = colors[i].alphaByte();
+		EXPECT_EQ(colors[i] * sdl::Color::createU32(alpha, alpha, alpha), result[i]);
+	}
+}
+
+TEST_F(Test, colorConvertToFloat4) {
+	// Given.
+	const auto colors = createColors(103);
+
+	// When.
+	std::vector<glm::vec4> result(colors.size());
+	sdl::color::convertToFloat4(colors, result);
+
+	// Then.
+	for (std::size_t i = 0; i < colors.size(); ++i) {
+		EXPECT_EQ(colors[i].red(), result[i].x);
+		EXPECT_EQ(colors[i].green(), result[i].y);
+		EXPECT_EQ(colors[i].blue(), result[i].z);
+		EXPECT_EQ(colors[i].alpha(), result[i].w);
+	}
+}
+
+TEST_F(Test, colorLerpEndPoints) {
+	// Given.
+	const auto from = createColors(103);
+	const auto to = createColors(103, 17);
+
+	// When.
+	std::vector<sdl::Color> start(from.size());
+	std::vector<sdl::Color> end(from.size());
+	sdl::color::lerp(from, to, 0.f, start);
+	sdl::color::lerp(from, to, 1.f, end);
+
+	// Then.
+	for (std::size_t i = 0; i < from.size(); ++i) {
+		EXPECT_NE(from[i], to[i]);
+		EXPECT_EQ(from[i], start[i]);
+		EXPECT_EQ(to[i], end[i]);
+	}
+}
+
+TEST_F(Test, colorLerpHalfWay) {
+	// Given.
+	const auto from = createColors(103);
+	const auto to = createColors(103, 17);
+	auto lerpByte = [](uint8_t a, uint8_t b) {
+		return static_cast<uint8_t>(a + 0.5f * (b - a) + 0.5f);
+	};
+
+	// When.
+	std::vector<sdl::Color> result(from.size());
+	sdl::color::lerp(from, to, 0.5f, result);
+
+	// Then.
+	for (std::size_t i = 0; i < from.size(); ++i) {
+		EXPECT_EQ(lerpByte(from[i].redByte(), to[i].redByte()), result[i].redByte());
+		EXPECT_EQ(lerpByte(from[i].greenByte(), to[i].greenByte()), result[i].greenByte());
+		EXPECT_EQ(lerpByte(from[i].blueByte(), to[i].blueByte()), result[i].blueByte());
+		EXPECT_EQ(lerpByte(from[i].alphaByte(), to[i].alphaByte()), result[i].alphaByte());
+	}
+}
+
+TEST_F(Test, colorSrgbToLinearKeepsAlphaAndEndPoints) {
+	// Given.
+	std::vector<sdl::Color> colors{sdl::Color::createU32(0, 255, 0, 77), sdl::Color::createU32(255, 0, 255, 12)};
+
+	// When.
+	auto result = colors;
+	sdl::color::srgbToLinear(result);
+
+	// Then.
+	EXPECT_EQ(colors, result);
+}
+
+TEST_F(Test, colorSrgbToLinearMidTones) {
+	// Given.
+	std::vector<sdl::Color> colors{sdl::Color::createU32(128, 188, 64, 128)};
+
+	// When.
+	auto result = colors;
+	sdl::color::srgbToLinear(result);
+
+	// Then.
+	EXPECT_EQ(sdl::Color::createU32(55, 128, 13, 128), result[0]);
+}
+
+class CompressedImageTest : public Test {
+protected:
+	void TearDown() override {
+		if (!path_.empty()) {
+			std::error_code error;
+			std::filesystem::remove(path_, error);
+		}
+	}
+
+	// Write to a file unique for the test and the run, i.e. parallel runs don't share files.
+	std::string writeFile(const std::vector<std::uint8_t>& data) {
+		const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+		path_ = std::filesystem::temp_directory_path() / (std::string{"cppsdl2_"} + info->test_suite_name() + "_" + info->name()
+			+ "_" + std::to_string(std::random_device{}()) + ".ktx2");
+		std::ofstream{path_, std::ios::binary}.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		return path_.string();
+	}
+
+private:
+	std::filesystem::path path_;
+};
+
+TEST_F(CompressedImageTest, loadsKtx2) {
+	// Given.
+	auto filename = writeFile(createKtx2(8, 6, 104, 4 * 8));
+
+	// When.
+	sdl::CompressedImage image{filename};
+
+	// Then.
+	ASSERT_TRUE(image.isLoaded());
+	EXPECT_EQ(8, image.getWidth());
+	EXPECT_EQ(6, image.getHeight());
+	EXPECT_EQ(1, image.getLevelCount());
+	EXPECT_EQ(32u, image.getLevelData(0).size());
+}
+
+TEST_F(CompressedImageTest, rejectsTruncatedKtx2) {
+	// Given.
+	auto data = createKtx2(8, 6, 104, 4 * 8);
+	data.resize(data.size() - 1);
+	auto filename = writeFile(data);
+
+	// When.
+	sdl::CompressedImage image{filename};
+
+	// Then.
+	EXPECT_FALSE(image.isLoaded());
+}
+
+TEST_F(CompressedImageTest, rejectsOutOfRangeOffset) {
+	// Given.
+	auto filename = writeFile(createKtx2(8, 6, std::numeric_limits<std::uint64_t>::max() - 8, 4 * 8));
+
+	// When.
+	sdl::CompressedImage image{filename};
+
+	// Then.
+	EXPECT_FALSE(image.isLoaded());
+}
+
+TEST_F(CompressedImageTest, rejectsTooLargeSize) {
+	// Given.
+	auto filename = writeFile(createKtx2(std::numeric_limits<std::uint32_t>::max() - 1, 4, 104, 4 * 8));
+
+	// When.
+	sdl::CompressedImage image{filename};
+
+	// Then.
+	EXPECT_FALSE(image.isLoaded());
+}
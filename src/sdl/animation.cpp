@@ -0,0 +1,224 @@
+#include "animation.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace sdl {
+
+	namespace {
+
+		float toInvSeconds(const DeltaTime& frameDuration) {
+			float seconds = std::chrono::duration<float>(frameDuration).count();
+			if (seconds <= 0.f) {
+				spdlog::warn("[sdl::AnimationClip] Frame duration must be positive");
+				return 0.f;
+			}
+			return 1.f / seconds;
+		}
+
+		template <typename Type>
+		void swapRemove(std::vector<Type>& vector, int index) {
+			vector[index] = vector.back();
+			vector.pop_back();
+		}
+
+	}
+
+	AnimationClip::AnimationClip(std::span<const TextureView> frames, const DeltaTime& frameDuration, bool looping)
+		: invFrameDuration_{toInvSeconds(frameDuration)}
+		, looping_{looping} {
+
+		if (frames.empty()) {
+			return;
+		}
+		texture_ = frames.front();
+		frames_.reserve(frames.size());
+		for (const auto& frame : frames) {
+			if (static_cast<gl::GLuint>(frame) != getTexture()) {
+				spdlog::warn("[sdl::AnimationClip] Frame uses another texture than the first frame");
+			}
+			frames_.push_back({frame.getPosition(), frame.getSize()});
+		}
+	}
+
+	AnimationClip::AnimationClip(const TextureView& sheet, int columns, int rows, const DeltaTime& frameDuration, bool looping, int frames)
+		: texture_{sheet}
+		, invFrameDuration_{toInvSeconds(frameDuration)}
+		, looping_{looping} {
+
+		if (columns <= 0 || rows <= 0) {
+			spdlog::warn("[sdl::AnimationClip] Columns and rows must be positive");
+			return;
+		}
+		int size = frames > 0 ? std::min(frames, columns * rows) : columns * rows;
+		glm::vec2 cell{sheet.getWidth() / columns, sheet.getHeight() / rows};
+
+		frames_.reserve(size);
+		for (int i = 0; i < size; ++i) {
+			int column = i % columns;
+			int row = i / columns;
+			frames_.push_back({sheet.getPosition() + glm::vec2{column * cell.x, row * cell.y}, cell});
+		}
+	}
+
+	int AnimationClip::getFrameIndex(float time) const noexcept {
+		if (frames_.empty()) {
+			return 0;
+		}
+		int index = static_cast<int>(std::max(time, 0.f) * invFrameDuration_);
+		if (looping_) {
+			return index % getSize();
+		}
+		return std::min(index, getSize() - 1);
+	}
+
+	TextureView AnimationClip::getFrame(int index) const noexcept {
+		if (index < 0 || index >= getSize()) {
+			return {};
+		}
+		const auto& frame = frames_[index];
+		return {texture_, frame.pos, frame.size};
+	}
+
+	int AnimatedSpriteBatch::addClip(const AnimationClip& clip) {
+		if (!clips_.empty() && clip.getTexture() != clips_.front().getTexture()) {
+			spdlog::error("[sdl::AnimatedSpriteBatch] Clip must use the same texture as the other clips");
+			return -1;
+		}
+		if (clip.getSize() == 0) {
+			spdlog::error("[sdl::AnimatedSpriteBatch] Clip has no frames");
+			return -1;
+		}
+		if (clip.getDuration() <= 0.f) {
+			spdlog::error("[sdl::AnimatedSpriteBatch] Clip duration must be positive");
+			return -1;
+		}
+		clips_.push_back(clip);
+		return static_cast<int>(clips_.size()) - 1;
+	}
+
+	int AnimatedSpriteBatch::add(int clipId, const glm::vec2& pos, const glm::vec2& size, Color color, float speed) {
+		if (clipId < 0 || clipId >= static_cast<int>(clips_.size())) {
+			spdlog::error("[sdl::AnimatedSpriteBatch] Invalid clip id {}", clipId);
+			return -1;
+		}
+		pos_.push_back(pos);
+		size_.push_back(size);
+		color_.push_back(color);
+		time_.push_back(0.f);
+		speed_.push_back(speed);
+		clip_.push_back(clipId);
+		frame_.push_back(0);
+		return getSize() - 1;
+	}
+
+	void AnimatedSpriteBatch::remove(int index) {
+		if (!isValidIndex(index)) {
+			return;
+		}
+		swapRemove(pos_, index);
+		swapRemove(size_, index);
+		swapRemove(color_, index);
+		swapRemove(time_, index);
+		swapRemove(speed_, index);
+		swapRemove(clip_, index);
+		swapRemove(frame_, index);
+	}
+
+	void AnimatedSpriteBatch::setPosition(int index, const glm::vec2& pos) {
+		if (isValidIndex(index)) {
+			pos_[index] = pos;
+		}
+	}
+
+	glm::vec2 AnimatedSpriteBatch::getPosition(int index) const {
+		if (isValidIndex(index)) {
+			return pos_[index];
+		}
+		return {};
+	}
+
+	void AnimatedSpriteBatch::play(int index, int clipId) {
+		if (!isValidIndex(index) || clipId < 0 || clipId >= static_cast<int>(clips_.size())) {
+			return;
+		}
+		clip_[index] = clipId;
+		time_[index] = 0.f;
+		frame_[index] = 0;
+	}
+
+	void AnimatedSpriteBatch::setSpeed(int index, float speed) {
+		if (isValidIndex(index)) {
+			speed_[index] = speed;
+		}
+	}
+
+	bool AnimatedSpriteBatch::isFinished(int index) const {
+		if (!isValidIndex(index)) {
+			return true;
+		}
+		const auto& clip = clips_[clip_[index]];
+		return !clip.isLooping() && time_[index] >= clip.getDuration();
+	}
+
+	void AnimatedSpriteBatch::update(const DeltaTime& deltaTime) {
+		float seconds = std::chrono::duration<float>(deltaTime).count();
+
+		const int size = getSize();
+		for (int i = 0; i < size; ++i) {
+			time_[i] += seconds * speed_[i];
+		}
+		for (int i = 0; i < size; ++i) {
+			const auto& clip = clips_[clip_[i]];
+			if (clip.isLooping() && (time_[i] >= clip.getDuration() || time_[i] < 0.f)) {
+				// Keep the time small in order to not lose float precision.
+				time_[i] = std::fmod(time_[i], clip.getDuration());
+				if (time_[i] < 0.f) {
+					// Played backwards.
+					time_[i] += clip.getDuration();
+				}
+			}
+			frame_[i] = clip.getFrameIndex(time_[i]);
+		}
+	}
+
+	void AnimatedSpriteBatch::draw(Graphic& graphic) const {
+		if (pos_.empty()) {
+			return;
+		}
+		graphic.addQuads(getSize(), clips_.front().texture_, [&](std::span<Vertex> vertexes) {
+			const int size = getSize();
+			for (int i = 0; i < size; ++i) {
+				const auto& uv = clips_[clip_[i]].frames_[frame_[i]];
+				const auto& pos = pos_[i];
+				const auto& quadSize = size_[i];
+				auto color = color_[i];
+
+				// Same texture mapping as graphic::addRectangleImage.
+				auto quad = vertexes.subspan(static_cast<std::size_t>(i) * 4, 4);
+				quad[0] = {pos, uv.pos + glm::vec2{0.f, uv.size.y}, color};
+				quad[1] = {pos + glm::vec2{quadSize.x, 0.f}, uv.pos + uv.size, color};
+				quad[2] = {pos + quadSize, uv.pos + glm::vec2{uv.size.x, 0.f}, color};
+				quad[3] = {pos + glm::vec2{0.f, quadSize.y}, uv.pos, color};
+			}
+		});
+	}
+
+	void AnimatedSpriteBatch::clear() {
+		pos_.clear();
+		size_.clear();
+		color_.clear();
+		time_.clear();
+		speed_.clear();
+		clip_.clear();
+		frame_.clear();
+	}
+
+	bool AnimatedSpriteBatch::isValidIndex(int index) const noexcept {
+		return index >= 0 && index < getSize();
+	}
+
+}
@@ -0,0 +1,136 @@
+#ifndef CPPSDL2_SDL_ANIMATION_H
+#define CPPSDL2_SDL_ANIMATION_H
+
+#include "color.h"
+#include "graphic.h"
+#include "textureview.h"
+#include "window.h"
+
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <vector>
+
+namespace sdl {
+
+	// Frames of a flipbook animation, stored contiguously as uv rects in the same texture.
+	class AnimationClip {
+	public:
+		AnimationClip() = default;
+
+		// Frames must be views into the same texture, e.g. from the same TextureAtlas.
+		AnimationClip(std::span<const TextureView> frames, const DeltaTime& frameDuration, bool looping = true);
+
+		// Split the sheet into a grid with columns x rows cells, read row by row starting at the
+		// upper left cell. Only the first frames cells are used, all cells if frames is zero or less.
+		AnimationClip(const TextureView& sheet, int columns, int rows, const DeltaTime& frameDuration, bool looping = true, int frames = 0);
+
+		// Return the frame index to be shown after time seconds.
+		int getFrameIndex(float time) const noexcept;
+
+		// Return the frame as a view into the texture.
+		TextureView getFrame(int index) const noexcept;
+
+		int getSize() const noexcept;
+
+		float getFrameDuration() const noexcept;
+
+		// Return the total duration in seconds.
+		float getDuration() const noexcept;
+
+		bool isLooping() const noexcept;
+
+		gl::GLuint getTexture() const noexcept;
+
+	private:
+		friend class AnimatedSpriteBatch;
+
+		struct UvRect {
+			glm::vec2 pos;
+			glm::vec2 size;
+		};
+
+		std::vector<UvRect> frames_;
+		TextureView texture_;
+		float invFrameDuration_ = 0.f;
+		bool looping_ = true;
+	};
+
+	// Many animated sprites sharing the clips' texture, updated and drawn in one pass.
+	class AnimatedSpriteBatch {
+	public:
+		AnimatedSpriteBatch() = default;
+
+		// Return the clip id. All clips must use the same texture, otherwise -1 is returned.
+		int addClip(const AnimationClip& clip);
+
+		// Return the instance index.
+		int add(int clipId, const glm::vec2& pos, const glm::vec2& size, Color color = color::White, float speed = 1.f);
+
+		// Remove the instance, the last instance takes the removed index.
+		void remove(int index);
+
+		void setPosition(int index, const glm::vec2& pos);
+
+		glm::vec2 getPosition(int index) const;
+
+		// Change clip and restart the animation.
+		void play(int index, int clipId);
+
+		// A negative speed plays the clip backwards, looping clips wrap around to the last frame.
+		void setSpeed(int index, float speed);
+
+		// Return true if a non looping animation has shown its last frame.
+		bool isFinished(int index) const;
+
+		// Advance the time for all instances.
+		void update(const DeltaTime& deltaTime);
+
+		// Add one quad per instance to the graphic.
+		void draw(Graphic& graphic) const;
+
+		void clear();
+
+		int getSize() const noexcept;
+
+	private:
+		bool isValidIndex(int index) const noexcept;
+
+		std::vector<AnimationClip> clips_;
+
+		std::vector<glm::vec2> pos_;
+		std::vector<glm::vec2> size_;
+		std::vector<Color> color_;
+		std::vector<float> time_;
+		std::vector<float> speed_;
+		std::vector<int> clip_;
+		std::vector<int> frame_;
+	};
+
+	inline int AnimationClip::getSize() const noexcept {
+		return static_cast<int>(frames_.size());
+	}
+
+	inline float AnimationClip::getFrameDuration() const noexcept {
+		return invFrameDuration_ > 0.f ? 1.f / invFrameDuration_ : 0.f;
+	}
+
+	inline float AnimationClip::getDuration() const noexcept {
+		return getFrameDuration() * getSize();
+	}
+
+	inline bool AnimationClip::isLooping() const noexcept {
+		return looping_;
+	}
+
+	inline gl::GLuint AnimationClip::getTexture() const noexcept {
+		return texture_;
+	}
+
+	inline int AnimatedSpriteBatch::getSize() const noexcept {
+		return static_cast<int>(pos_.size());
+	}
+
+}
+
+#endif
@@ -1,11 +1,13 @@
 #ifndef CPPSDL2_SDL_BATCH_H
 #define CPPSDL2_SDL_BATCH_H
 
+#include "renderstats.h"
 #include "vertexbufferobject.h"
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <span>
 #include <vector>
 
 namespace sdl {
@@ -161,7 +163,7 @@ namespace sdl {
 		vbo_{std::move(other.vbo_)},
 
 		currentViewIndex_{std::exchange(other.currentViewIndex_, 0)},
-		usage_{std::exchange(other.usage_, 0)}
+		usage_{std::exchange(other.usage_, gl::GLenum{})}
 	{ }
 
 	template <VertexType Vertex>
@@ -170,7 +172,7 @@ namespace sdl {
 		vbo_ = std::move(other.vbo_);
 
 		currentViewIndex_ = std::exchange(other.currentViewIndex_, 0);
-		usage_ = std::exchange(other.usage_, 0);
+		usage_ = std::exchange(other.usage_, gl::GLenum{});
 		return *this;
 	}
 
@@ -259,6 +261,9 @@ namespace sdl {
 				return;
 			}
 
+			auto& stats = renderstats::current();
+			++stats.drawCalls;
+			stats.vertexes += batchView.size_;
 			glDrawArrays(batchView.mode_, batchView.index_, batchView.size_);
 		} else if (!vbo_.isGenerated()) {
 			spdlog::error("[sdl::Batch] Vertex data failed to draw, no vbo binded, i.e. Batch::uploadToGraphicCard never called");
@@ -366,6 +371,9 @@ namespace sdl {
 		void insert(std::initializer_list<Vertex> list);
 		void pushBack(const Vertex& vertex);
 
+		// Append size vertexes and return them, in order to be written in place.
+		std::span<Vertex> growVertexes(gl::GLsizei size);
+
 		bool isEmpty() const noexcept;
 		gl::GLsizei getSize() const noexcept;
 		const Vertex* getData() const noexcept;
@@ -376,6 +384,9 @@ namespace sdl {
 		void insertIndexes(std::initializer_list<gl::GLint> list);
 		void pushBackIndex(gl::GLint index);
 
+		// Append size indexes and return them, in order to be written in place.
+		std::span<gl::GLint> growIndexes(gl::GLsizei size);
+
 		gl::GLsizei getIndexesSize() const noexcept;
 		const gl::GLint* getIndexData() const noexcept;
 
@@ -411,6 +422,15 @@ namespace sdl {
 		vertexes_.push_back(vertex);
 	}
 
+	template <VertexType Vertex>
+	std::span<Vertex> SubBatchIndexed<Vertex>::growVertexes(gl::GLsizei size) {
+		assert(size >= 0);
+
+		auto oldSize = vertexes_.size();
+		vertexes_.resize(oldSize + size);
+		return {vertexes_.data() + oldSize, static_cast<std::size_t>(size)};
+	}
+
 	template <VertexType Vertex>
 	bool SubBatchIndexed<Vertex>::isEmpty() const noexcept {
 		return vertexes_.empty();
@@ -443,6 +463,15 @@ namespace sdl {
 		indexes_.push_back(index);
 	}
 
+	template <VertexType Vertex>
+	std::span<gl::GLint> SubBatchIndexed<Vertex>::growIndexes(gl::GLsizei size) {
+		assert(size >= 0);
+
+		auto oldSize = indexes_.size();
+		indexes_.resize(oldSize + size);
+		return {indexes_.data() + oldSize, static_cast<std::size_t>(size)};
+	}
+
 	template <VertexType Vertex>
 	gl::GLsizei SubBatchIndexed<Vertex>::getIndexesSize() const noexcept {
 		return static_cast<gl::GLsizei>(indexes_.size());
@@ -528,6 +557,14 @@ namespace sdl {
 		void pushBackIndex(gl::GLint index);
 		bool isEveryIndexSizeValid() const;
 
+		// Append size vertexes and return them, in order to be written in place without
+		// a function call per vertex. Return an empty span if the data is static and uploaded.
+		std::span<Vertex> growVertexes(gl::GLsizei size);
+
+		// Append the indexes for size quads (two triangles each, i.e. 0, 1, 2, 0, 2, 3),
+		// relative to the last call to startAdding(). Each quad uses four vertexes.
+		void insertQuadIndexes(gl::GLsizei size);
+
 	private:
 		void bindAndBufferData();
 		void bindAndBufferSubData();
@@ -556,7 +593,7 @@ namespace sdl {
 
 		currentViewIndex_{std::exchange(other.currentViewIndex_, 0)},
 		currentIndexesIndex_{std::exchange(other.currentIndexesIndex_, 0)},
-		usage_{std::exchange(other.usage_, 0)}
+		usage_{std::exchange(other.usage_, gl::GLenum{})}
 	{ }
 
 	template <VertexType Vertex>
@@ -567,7 +604,7 @@ namespace sdl {
 
 		currentViewIndex_ = std::exchange(other.currentViewIndex_, 0);
 		currentIndexesIndex_ = std::exchange(other.currentIndexesIndex_, 0);
-		usage_ = std::exchange(other.usage_, 0);
+		usage_ = std::exchange(other.usage_, gl::GLenum{});
 		return *this;
 	}
 
@@ -673,6 +710,9 @@ namespace sdl {
 			}
 			
 			assert(batchView.isIndexSizeValid());
+			auto& stats = renderstats::current();
+			++stats.drawCalls;
+			stats.indexes += batchView.size_;
 			glDrawElements(batchView.mode_, batchView.size_, gl::GL_UNSIGNED_INT, reinterpret_cast<void*>(batchView.index_ * sizeof(gl::GLint)));
 		} else if (!vbo_.isGenerated()) {
 			spdlog::error("[sdl::Batch] Vertex data failed to draw, no vbo binded, i.e. Batch::uploadToGraphicCard never called");
@@ -753,6 +793,34 @@ namespace sdl {
 		return fullBatch_.isEveryIndexSizeValid();
 	}
 
+	template <VertexType Vertex>
+	std::span<Vertex> BatchIndexed<Vertex>::growVertexes(gl::GLsizei size) {
+		if (vbo_.getSize() != 0 && usage_ == gl::GL_STATIC_DRAW) {
+			spdlog::error("[sdl::Batch] VertexData is static, data can't be modified");
+			return {};
+		}
+		return fullBatch_.growVertexes(size);
+	}
+
+	template <VertexType Vertex>
+	void BatchIndexed<Vertex>::insertQuadIndexes(gl::GLsizei size) {
+		if (vbo_.getSize() != 0 && usage_ == gl::GL_STATIC_DRAW) {
+			spdlog::error("[sdl::Batch] Vertex data is static, data index can't be modified");
+			return;
+		}
+		auto indexes = fullBatch_.growIndexes(size * 6);
+		auto index = static_cast<gl::GLint>(currentIndexesIndex_);
+		for (gl::GLsizei i = 0; i < size; ++i, index += 4) {
+			auto quad = indexes.subspan(i * 6, 6);
+			quad[0] = index;
+			quad[1] = index + 1;
+			quad[2] = index + 2;
+			quad[3] = index;
+			quad[4] = index + 2;
+			quad[5] = index + 3;
+		}
+	}
+
 }
 
 #endif
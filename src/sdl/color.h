@@ -129,7 +129,7 @@ namespace sdl {
 	}
 
 	inline constexpr Color operator*(Color left, Color right) noexcept {
-		return Color{left.red() * right.redByte(), left.green() * right.greenByte(), left.blue() * right.blueByte(), left.alpha() * right.alphaByte()};
+		return Color{left.red() * right.red(), left.green() * right.green(), left.blue() * right.blue(), left.alpha() * right.alpha()};
 	}
 
 	inline constexpr Color operator+(Color left, Color right) noexcept {
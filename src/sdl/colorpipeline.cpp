@@ -0,0 +1,72 @@
+#include "colorpipeline.h"
+#include "glstate.h"
+
+namespace sdl::colorpipeline {
+
+	namespace {
+
+		bool linear_ = false;
+		bool premultipliedAlpha_ = false;
+
+	}
+
+	void setLinear(bool linear) {
+		linear_ = linear;
+	}
+
+	bool isLinear() {
+		return linear_;
+	}
+
+	void setPremultipliedAlpha(bool premultipliedAlpha) {
+		premultipliedAlpha_ = premultipliedAlpha;
+	}
+
+	bool isPremultipliedAlpha() {
+		return premultipliedAlpha_;
+	}
+
+	void apply() {
+		glstate::setEnabled(gl::GL_FRAMEBUFFER_SRGB, linear_);
+		if (premultipliedAlpha_) {
+			gl::glBlendFunc(gl::GL_ONE, gl::GL_ONE_MINUS_SRC_ALPHA);
+		} else {
+			gl::glBlendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+		}
+	}
+
+	ShaderFeatures getShaderFeatures() {
+		auto features = ShaderFeatures::None;
+		if (linear_) {
+			features = features | ShaderFeatures::LinearColor;
+		}
+		if (premultipliedAlpha_) {
+			features = features | ShaderFeatures::PremultipliedAlpha;
+		}
+		return features;
+	}
+
+	gl::GLenum getInternalFormat(gl::GLenum format) {
+		if (linear_) {
+			if (format == gl::GL_RGBA || format == gl::GL_RGBA8) {
+				return gl::GL_SRGB8_ALPHA8;
+			}
+			switch (format) {
+				case gl::GL_RGB: return gl::GL_SRGB8;
+				// Compressed color formats, the data is interpreted as sRGB without conversion.
+				case gl::GL_COMPRESSED_RGB_S3TC_DXT1_EXT: return gl::GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+				case gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+				case gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+				case gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+				case gl::GL_COMPRESSED_RGBA_BPTC_UNORM: return gl::GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+				case gl::GL_COMPRESSED_RGB8_ETC2: return gl::GL_COMPRESSED_SRGB8_ETC2;
+				case gl::GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2: return gl::GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+				case gl::GL_COMPRESSED_RGBA8_ETC2_EAC: return gl::GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+				case gl::GL_COMPRESSED_RGBA_ASTC_4x4_KHR: return gl::GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR;
+				default: break;
+			}
+		}
+		return format;
+	}
+
+}
@@ -0,0 +1,35 @@
+#ifndef CPPSDL2_SDL_COLORPIPELINE_H
+#define CPPSDL2_SDL_COLORPIPELINE_H
+
+#include "color.h"
+#include "shader.h"
+
+// Optional color pipeline, set once before any surfaces or textures are loaded.
+// Linear: textures are uploaded as sRGB and the framebuffer encodes to sRGB, i.e. shading
+// and blending is done in linear light.
+// Premultiplied alpha: surfaces are premultiplied when loaded and blended with
+// GL_ONE, GL_ONE_MINUS_SRC_ALPHA, i.e. alpha blended and additive (alpha 0) pixels can
+// be drawn in the same draw call.
+namespace sdl::colorpipeline {
+
+	void setLinear(bool linear);
+
+	bool isLinear();
+
+	void setPremultipliedAlpha(bool premultipliedAlpha);
+
+	bool isPremultipliedAlpha();
+
+	// Set GL_FRAMEBUFFER_SRGB and the blend function for the pipeline. Blending must be enabled separately.
+	void apply();
+
+	// Return the shader features converting straight sRGB vertex colors for the pipeline.
+	ShaderFeatures getShaderFeatures();
+
+	// Return the texture internal format for the pixel format, e.g. GL_SRGB8_ALPHA8 for GL_RGBA if linear.
+	// Compressed color formats map to their sRGB variant, data formats like RGTC are unchanged.
+	gl::GLenum getInternalFormat(gl::GLenum format);
+
+}
+
+#endif
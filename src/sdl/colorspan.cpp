@@ -0,0 +1,246 @@
+#include "colorspan.h"
+#include "simd.h"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+namespace sdl::color {
+
+	namespace {
+
+		static_assert(sizeof(Color) == sizeof(ImU32));
+		static_assert(sizeof(glm::vec4) == 4 * sizeof(float));
+
+		// The SIMD code paths assume the channels in memory order red, green, blue and alpha.
+		constexpr bool RgbaLayout = IM_COL32_R_SHIFT == 0 && IM_COL32_G_SHIFT == 8 && IM_COL32_B_SHIFT == 16 && IM_COL32_A_SHIFT == 24;
+
+		// Round(a * b / 255) without division.
+		constexpr std::uint8_t mulDiv255(unsigned a, unsigned b) noexcept {
+			const unsigned x = a * b + 128;
+			return static_cast<std::uint8_t>((x + (x >> 8)) >> 8);
+		}
+
+		std::uint8_t lerpByte(std::uint8_t from, std::uint8_t to, float t) noexcept {
+			const float a = from;
+			const float b = to;
+			return static_cast<std::uint8_t>(std::clamp(static_cast<int>(a + t * (b - a) + 0.5f), 0, 255));
+		}
+
+		struct SrgbTables {
+			std::array<std::uint8_t, 256> toLinear;
+			std::array<std::uint8_t, 256> toSrgb;
+			std::array<float, 256> toLinearFloat;
+		};
+
+		const SrgbTables& srgbTables() {
+			static const SrgbTables tables = [] {
+				SrgbTables tables;
+				for (int i = 0; i < 256; ++i) {
+					const float value = i / 255.f;
+					const float linear = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+					const float srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+					tables.toLinearFloat[i] = linear;
+					tables.toLinear[i] = static_cast<std::uint8_t>(linear * 255.f + 0.5f);
+					tables.toSrgb[i] = static_cast<std::uint8_t>(srgb * 255.f + 0.5f);
+				}
+				return tables;
+			}();
+			return tables;
+		}
+
+		void applyTable(std::span<Color> colors, const std::array<std::uint8_t, 256>& table) noexcept {
+			for (auto& color : colors) {
+				color = Color::createU32(table[color.redByte()], table[color.greenByte()], table[color.blueByte()], color.alphaByte());
+			}
+		}
+
+#if CPPSDL2_SSE2
+		// Round(a * b / 255) for each 16 bit lane, where a and b are at most 255.
+		__m128i mulDiv255(__m128i a, __m128i b) noexcept {
+			const auto x = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+		}
+#endif
+
+#if CPPSDL2_AVX2
+		__m256i mulDiv255(__m256i a, __m256i b) noexcept {
+			const auto x = _mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+		}
+#endif
+
+	}
+
+	void convertToFloat4(std::span<const Color> colors, std::span<glm::vec4> out) noexcept {
+		assert(out.size() >= colors.size());
+		std::size_t i = 0;
+		if constexpr (RgbaLayout) {
+			[[maybe_unused]] auto src = reinterpret_cast<const ImU32*>(colors.data());
+			[[maybe_unused]] auto dst = reinterpret_cast<float*>(out.data());
+#if CPPSDL2_AVX2
+			const auto scale = _mm256_set1_ps(255.f);
+			for (; i + 2 <= colors.size(); i += 2) {
+				const auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+				_mm256_storeu_ps(dst + 4 * i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)), scale));
+			}
+#elif CPPSDL2_SSE2
+			const auto zero = _mm_setzero_si128();
+			const auto scale = _mm_set1_ps(255.f);
+			for (; i + 4 <= colors.size(); i += 4) {
+				const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				const auto lo = _mm_unpacklo_epi8(bytes, zero);
+				const auto hi = _mm_unpackhi_epi8(bytes, zero);
+				_mm_storeu_ps(dst + 4 * i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+				_mm_storeu_ps(dst + 4 * i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+				_mm_storeu_ps(dst + 4 * i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+				_mm_storeu_ps(dst + 4 * i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+			}
+#endif
+		}
+		for (; i < colors.size(); ++i) {
+			const auto color = colors[i];
+			out[i] = {color.red(), color.green(), color.blue(), color.alpha()};
+		}
+	}
+
+	void lerp(std::span<const Color> from, std::span<const Color> to, float t, std::span<Color> out) noexcept {
+		assert(to.size() >= from.size() && out.size() >= from.size());
+		std::size_t i = 0;
+		if constexpr (RgbaLayout) {
+#if CPPSDL2_SSE2
+			auto a = reinterpret_cast<const ImU32*>(from.data());
+			auto b = reinterpret_cast<const ImU32*>(to.data());
+			auto dst = reinterpret_cast<ImU32*>(out.data());
+
+			const auto zero = _mm_setzero_si128();
+			const auto factor = _mm_set1_ps(t);
+			const auto half = _mm_set1_ps(0.5f);
+			// One color per call, as 32 bit lanes.
+			auto lerpColor = [&](__m128i a, __m128i b) {
+				const auto fa = _mm_cvtepi32_ps(a);
+				const auto fb = _mm_cvtepi32_ps(b);
+				return _mm_cvttps_epi32(_mm_add_ps(_mm_add_ps(fa, _mm_mul_ps(factor, _mm_sub_ps(fb, fa))), half));
+			};
+			for (; i + 4 <= from.size(); i += 4) {
+				const auto bytesA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+				const auto bytesB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+				const auto loA = _mm_unpacklo_epi8(bytesA, zero);
+				const auto hiA = _mm_unpackhi_epi8(bytesA, zero);
+				const auto loB = _mm_unpacklo_epi8(bytesB, zero);
+				const auto hiB = _mm_unpackhi_epi8(bytesB, zero);
+				const auto first = _mm_packs_epi32(
+					lerpColor(_mm_unpacklo_epi16(loA, zero), _mm_unpacklo_epi16(loB, zero)),
+					lerpColor(_mm_unpackhi_epi16(loA, zero), _mm_unpackhi_epi16(loB, zero)));
+				const auto second = _mm_packs_epi32(
+					lerpColor(_mm_unpacklo_epi16(hiA, zero), _mm_unpacklo_epi16(hiB, zero)),
+					lerpColor(_mm_unpackhi_epi16(hiA, zero), _mm_unpackhi_epi16(hiB, zero)));
+				// Saturates to [0, 255], i.e. the same as the clamp in the scalar code.
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(first, second));
+			}
+#endif
+		}
+		for (; i < from.size(); ++i) {
+			const auto a = from[i];
+			const auto b = to[i];
+			out[i] = Color::createU32(lerpByte(a.redByte(), b.redByte(), t), lerpByte(a.greenByte(), b.greenByte(), t),
+				lerpByte(a.blueByte(), b.blueByte(), t), lerpByte(a.alphaByte(), b.alphaByte(), t));
+		}
+	}
+
+	void premultiplyAlpha(std::span<Color> colors) noexcept {
+		std::size_t i = 0;
+		if constexpr (RgbaLayout) {
+			[[maybe_unused]] auto data = reinterpret_cast<ImU32*>(colors.data());
+#if CPPSDL2_SSE2
+			// Two colors per 16 bit vector, the alpha lanes are multiplied with 255, i.e. unchanged.
+			const auto rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+			const auto alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+#endif
+#if CPPSDL2_AVX2
+			const auto zero256 = _mm256_setzero_si256();
+			const auto rgbMask256 = _mm256_broadcastsi128_si256(rgbMask);
+			const auto alphaOne256 = _mm256_broadcastsi128_si256(alphaOne);
+			auto premultiply256 = [&](__m256i x) {
+				const auto alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+				return mulDiv255(x, _mm256_or_si256(_mm256_and_si256(alpha, rgbMask256), alphaOne256));
+			};
+			for (; i + 8 <= colors.size(); i += 8) {
+				const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+				const auto lo = premultiply256(_mm256_unpacklo_epi8(bytes, zero256));
+				const auto hi = premultiply256(_mm256_unpackhi_epi8(bytes, zero256));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_packus_epi16(lo, hi));
+			}
+#endif
+#if CPPSDL2_SSE2
+			const auto zero = _mm_setzero_si128();
+			auto premultiply = [&](__m128i x) {
+				const auto alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+				return mulDiv255(x, _mm_or_si128(_mm_and_si128(alpha, rgbMask), alphaOne));
+			};
+			for (; i + 4 <= colors.size(); i += 4) {
+				const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				const auto lo = premultiply(_mm_unpacklo_epi8(bytes, zero));
+				const auto hi = premultiply(_mm_unpackhi_epi8(bytes, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_packus_epi16(lo, hi));
+			}
+#endif
+		}
+		for (; i < colors.size(); ++i) {
+			auto& color = colors[i];
+			const auto alpha = color.alphaByte();
+			color = Color::createU32(mulDiv255(color.redByte(), alpha), mulDiv255(color.greenByte(), alpha), mulDiv255(color.blueByte(), alpha), alpha);
+		}
+	}
+
+	void multiply(std::span<Color> colors, Color tint) noexcept {
+		std::size_t i = 0;
+		if constexpr (RgbaLayout) {
+			[[maybe_unused]] auto data = reinterpret_cast<ImU32*>(colors.data());
+			[[maybe_unused]] const auto value = static_cast<int>(tint.toImU32());
+#if CPPSDL2_AVX2
+			const auto zero256 = _mm256_setzero_si256();
+			const auto tint256 = _mm256_unpacklo_epi8(_mm256_set1_epi32(value), zero256);
+			for (; i + 8 <= colors.size(); i += 8) {
+				const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+				const auto lo = mulDiv255(_mm256_unpacklo_epi8(bytes, zero256), tint256);
+				const auto hi = mulDiv255(_mm256_unpackhi_epi8(bytes, zero256), tint256);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_packus_epi16(lo, hi));
+			}
+#endif
+#if CPPSDL2_SSE2
+			const auto zero = _mm_setzero_si128();
+			const auto tint128 = _mm_unpacklo_epi8(_mm_set1_epi32(value), zero);
+			for (; i + 4 <= colors.size(); i += 4) {
+				const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				const auto lo = mulDiv255(_mm_unpacklo_epi8(bytes, zero), tint128);
+				const auto hi = mulDiv255(_mm_unpackhi_epi8(bytes, zero), tint128);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_packus_epi16(lo, hi));
+			}
+#endif
+		}
+		for (; i < colors.size(); ++i) {
+			colors[i] *= tint;
+		}
+	}
+
+	void srgbToLinear(std::span<Color> colors) noexcept {
+		// A table lookup per channel, there is no byte gather in SSE2/AVX2.
+		applyTable(colors, srgbTables().toLinear);
+	}
+
+	void linearToSrgb(std::span<Color> colors) noexcept {
+		applyTable(colors, srgbTables().toSrgb);
+	}
+
+	void srgbToLinear(std::span<const Color> colors, std::span<glm::vec4> out) noexcept {
+		assert(out.size() >= colors.size());
+		const auto& table = srgbTables().toLinearFloat;
+		for (std::size_t i = 0; i < colors.size(); ++i) {
+			const auto color = colors[i];
+			out[i] = {table[color.redByte()], table[color.greenByte()], table[color.blueByte()], color.alpha()};
+		}
+	}
+
+}
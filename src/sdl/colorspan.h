@@ -0,0 +1,37 @@
+#ifndef CPPSDL2_SDL_COLORSPAN_H
+#define CPPSDL2_SDL_COLORSPAN_H
+
+#include "color.h"
+
+#include <glm/vec4.hpp>
+
+#include <span>
+
+// Bulk operations on colors, using SSE2/AVX2 when available. The results are the same as
+// the scalar Color operators. The out spans must be at least as large as the in spans.
+namespace sdl::color {
+
+	// Same as Color::red(), green(), blue() and alpha() for each color.
+	void convertToFloat4(std::span<const Color> colors, std::span<glm::vec4> out) noexcept;
+
+	// Per channel from + t * (to - from), rounded to the nearest byte.
+	void lerp(std::span<const Color> from, std::span<const Color> to, float t, std::span<Color> out) noexcept;
+
+	// Multiply the rgb channels with the alpha channel.
+	void premultiplyAlpha(std::span<Color> colors) noexcept;
+
+	// Same as color *= tint for each color.
+	void multiply(std::span<Color> colors, Color tint) noexcept;
+
+	// Convert the rgb channels between sRGB and linear space using lookup tables, the alpha is
+	// kept. Eight bits are not enough for linear colors, dark colors loose precision.
+	void srgbToLinear(std::span<Color> colors) noexcept;
+
+	void linearToSrgb(std::span<Color> colors) noexcept;
+
+	// Convert the sRGB colors to linear floats, without loss of precision.
+	void srgbToLinear(std::span<const Color> colors, std::span<glm::vec4> out) noexcept;
+
+}
+
+#endif
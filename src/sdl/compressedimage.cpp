@@ -0,0 +1,500 @@
+#include "compressedimage.h"
+#include "opengl.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace sdl {
+
+	namespace {
+
+		enum class Family {
+			S3tc,
+			Rgtc,
+			Bptc,
+			Etc2,
+			Astc
+		};
+
+		struct FormatInfo {
+			gl::GLenum format;
+			Family family;
+			int blockBytes;
+			bool srgb;
+		};
+
+		// All formats use 4x4 blocks.
+		constexpr std::array Formats{
+			FormatInfo{gl::GL_COMPRESSED_RGB_S3TC_DXT1_EXT, Family::S3tc, 8, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, Family::S3tc, 8, true},
+			FormatInfo{gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, Family::S3tc, 8, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, Family::S3tc, 8, true},
+			FormatInfo{gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, Family::S3tc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, Family::S3tc, 16, true},
+			FormatInfo{gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, Family::S3tc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, Family::S3tc, 16, true},
+			FormatInfo{gl::GL_COMPRESSED_RED_RGTC1, Family::Rgtc, 8, false},
+			FormatInfo{gl::GL_COMPRESSED_SIGNED_RED_RGTC1, Family::Rgtc, 8, false},
+			FormatInfo{gl::GL_COMPRESSED_RG_RGTC2, Family::Rgtc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_SIGNED_RG_RGTC2, Family::Rgtc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, Family::Bptc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, Family::Bptc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_RGBA_BPTC_UNORM, Family::Bptc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, Family::Bptc, 16, true},
+			FormatInfo{gl::GL_COMPRESSED_RGB8_ETC2, Family::Etc2, 8, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB8_ETC2, Family::Etc2, 8, true},
+			FormatInfo{gl::GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, Family::Etc2, 8, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2, Family::Etc2, 8, true},
+			FormatInfo{gl::GL_COMPRESSED_RGBA8_ETC2_EAC, Family::Etc2, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, Family::Etc2, 16, true},
+			FormatInfo{gl::GL_COMPRESSED_RGBA_ASTC_4x4_KHR, Family::Astc, 16, false},
+			FormatInfo{gl::GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR, Family::Astc, 16, true}
+		};
+
+		const FormatInfo* findFormat(gl::GLenum format) {
+			auto it = std::find_if(Formats.begin(), Formats.end(), [format](const FormatInfo& info) {
+				return info.format == format;
+			});
+			return it != Formats.end() ? &*it : nullptr;
+		}
+
+		// Vulkan formats used by KTX2, e.g. VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131.
+		gl::GLenum vkFormatToGl(std::uint32_t vkFormat) {
+			switch (vkFormat) {
+				case 131: return gl::GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+				case 132: return gl::GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+				case 133: return gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+				case 134: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+				case 135: return gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+				case 136: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+				case 137: return gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+				case 138: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+				case 139: return gl::GL_COMPRESSED_RED_RGTC1;
+				case 140: return gl::GL_COMPRESSED_SIGNED_RED_RGTC1;
+				case 141: return gl::GL_COMPRESSED_RG_RGTC2;
+				case 142: return gl::GL_COMPRESSED_SIGNED_RG_RGTC2;
+				case 143: return gl::GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+				case 144: return gl::GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+				case 145: return gl::GL_COMPRESSED_RGBA_BPTC_UNORM;
+				case 146: return gl::GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+				case 147: return gl::GL_COMPRESSED_RGB8_ETC2;
+				case 148: return gl::GL_COMPRESSED_SRGB8_ETC2;
+				case 149: return gl::GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+				case 150: return gl::GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+				case 151: return gl::GL_COMPRESSED_RGBA8_ETC2_EAC;
+				case 152: return gl::GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+				case 157: return gl::GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+				case 158: return gl::GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR;
+			}
+			return {};
+		}
+
+		gl::GLenum dxgiFormatToGl(std::uint32_t dxgiFormat) {
+			switch (dxgiFormat) {
+				case 71: return gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+				case 72: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+				case 74: return gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+				case 75: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+				case 77: return gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+				case 78: return gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+				case 80: return gl::GL_COMPRESSED_RED_RGTC1;
+				case 81: return gl::GL_COMPRESSED_SIGNED_RED_RGTC1;
+				case 83: return gl::GL_COMPRESSED_RG_RGTC2;
+				case 84: return gl::GL_COMPRESSED_SIGNED_RG_RGTC2;
+				case 95: return gl::GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+				case 96: return gl::GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+				case 98: return gl::GL_COMPRESSED_RGBA_BPTC_UNORM;
+				case 99: return gl::GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+			}
+			return {};
+		}
+
+		constexpr std::uint32_t fourCC(const char (&code)[5]) {
+			return static_cast<std::uint32_t>(code[0]) | (static_cast<std::uint32_t>(code[1]) << 8)
+				| (static_cast<std::uint32_t>(code[2]) << 16) | (static_cast<std::uint32_t>(code[3]) << 24);
+		}
+
+		gl::GLenum fourCCToGl(std::uint32_t code) {
+			switch (code) {
+				case fourCC("DXT1"): return gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+				case fourCC("DXT3"): return gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+				case fourCC("DXT5"): return gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+				case fourCC("ATI1"): [[fallthrough]];
+				case fourCC("BC4U"): return gl::GL_COMPRESSED_RED_RGTC1;
+				case fourCC("BC4S"): return gl::GL_COMPRESSED_SIGNED_RED_RGTC1;
+				case fourCC("ATI2"): [[fallthrough]];
+				case fourCC("BC5U"): return gl::GL_COMPRESSED_RG_RGTC2;
+				case fourCC("BC5S"): return gl::GL_COMPRESSED_SIGNED_RG_RGTC2;
+			}
+			return {};
+		}
+
+		template <typename T>
+		T read(const std::vector<std::uint8_t>& data, std::size_t offset) {
+			T value{};
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			return value;
+		}
+
+		constexpr std::array<std::uint8_t, 12> Ktx2Identifier{
+			0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+		};
+
+		constexpr std::size_t Ktx2HeaderSize = 80;
+		constexpr std::size_t Ktx2LevelIndexSize = 24;
+		constexpr std::size_t DdsHeaderSize = 128;
+		constexpr std::size_t DdsDx10HeaderSize = 20;
+		constexpr std::uint32_t DdsMipMapCountFlag = 0x20000;
+
+		// Larger sizes overflow the block count.
+		constexpr std::uint32_t MaxSize = std::numeric_limits<int>::max() - 3;
+
+		bool isSignedFormat(gl::GLenum format) {
+			return format == gl::GL_COMPRESSED_SIGNED_RED_RGTC1 || format == gl::GL_COMPRESSED_SIGNED_RG_RGTC2;
+		}
+
+		void expand565(std::uint16_t color, std::uint8_t* rgb) {
+			const int r = (color >> 11) & 0x1f;
+			const int g = (color >> 5) & 0x3f;
+			const int b = color & 0x1f;
+			rgb[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+			rgb[1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+			rgb[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+		}
+
+		// Decode a BC1 color block into 16 RGBA pixels. BC2 and BC3 always use four colors.
+		void decodeColorBlock(const std::uint8_t* block, std::uint8_t* pixels, bool alwaysFourColors, bool punchThroughAlpha) {
+			const auto c0 = static_cast<std::uint16_t>(block[0] | (block[1] << 8));
+			const auto c1 = static_cast<std::uint16_t>(block[2] | (block[3] << 8));
+			std::uint8_t palette[4][4]{};
+			expand565(c0, palette[0]);
+			expand565(c1, palette[1]);
+			palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+			for (int i = 0; i < 3; ++i) {
+				if (c0 > c1 || alwaysFourColors) {
+					palette[2][i] = static_cast<std::uint8_t>((2 * palette[0][i] + palette[1][i]) / 3);
+					palette[3][i] = static_cast<std::uint8_t>((palette[0][i] + 2 * palette[1][i]) / 3);
+				} else {
+					palette[2][i] = static_cast<std::uint8_t>((palette[0][i] + palette[1][i]) / 2);
+					palette[3][i] = 0;
+				}
+			}
+			if (c0 <= c1 && !alwaysFourColors && punchThroughAlpha) {
+				palette[3][3] = 0;
+			}
+			std::uint32_t indices = 0;
+			std::memcpy(&indices, block + 4, sizeof(indices));
+			for (int i = 0; i < 16; ++i) {
+				std::memcpy(pixels + 4 * i, palette[(indices >> (2 * i)) & 0x3], 4);
+			}
+		}
+
+		// Decode a BC3 alpha or BC4 block into 16 values, stored with the stride in bytes.
+		void decodeAlphaBlock(const std::uint8_t* block, std::uint8_t* values, int stride) {
+			const int a0 = block[0];
+			const int a1 = block[1];
+			std::uint8_t palette[8]{static_cast<std::uint8_t>(a0), static_cast<std::uint8_t>(a1)};
+			if (a0 > a1) {
+				for (int i = 1; i < 7; ++i) {
+					palette[i + 1] = static_cast<std::uint8_t>(((7 - i) * a0 + i * a1) / 7);
+				}
+			} else {
+				for (int i = 1; i < 5; ++i) {
+					palette[i + 1] = static_cast<std::uint8_t>(((5 - i) * a0 + i * a1) / 5);
+				}
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+			std::uint64_t indices = 0;
+			for (int i = 0; i < 6; ++i) {
+				indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+			}
+			for (int i = 0; i < 16; ++i) {
+				values[i * stride] = palette[(indices >> (3 * i)) & 0x7];
+			}
+		}
+
+		// Decode a block of the format into 4x4 RGBA pixels, rows first.
+		void decodeBlock(gl::GLenum format, const std::uint8_t* block, std::uint8_t* pixels) {
+			switch (format) {
+				case gl::GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+				case gl::GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+					decodeColorBlock(block, pixels, false, false);
+					break;
+				case gl::GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+				case gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+					decodeColorBlock(block, pixels, false, true);
+					break;
+				case gl::GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+				case gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+					decodeColorBlock(block + 8, pixels, true, false);
+					for (int i = 0; i < 16; ++i) {
+						const int alpha = (block[i / 2] >> (4 * (i % 2))) & 0xf;
+						pixels[4 * i + 3] = static_cast<std::uint8_t>(alpha * 17);
+					}
+					break;
+				case gl::GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+				case gl::GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+					decodeColorBlock(block + 8, pixels, true, false);
+					decodeAlphaBlock(block, pixels + 3, 4);
+					break;
+				case gl::GL_COMPRESSED_RED_RGTC1:
+					for (int i = 0; i < 16; ++i) {
+						pixels[4 * i + 1] = pixels[4 * i + 2] = 0;
+						pixels[4 * i + 3] = 255;
+					}
+					decodeAlphaBlock(block, pixels, 4);
+					break;
+				case gl::GL_COMPRESSED_RG_RGTC2:
+					for (int i = 0; i < 16; ++i) {
+						pixels[4 * i + 2] = 0;
+						pixels[4 * i + 3] = 255;
+					}
+					decodeAlphaBlock(block, pixels, 4);
+					decodeAlphaBlock(block + 8, pixels + 1, 4);
+					break;
+				default:
+					break;
+			}
+		}
+
+	}
+
+	CompressedImage::CompressedImage(const std::string& filename) {
+		std::ifstream file{filename, std::ios::binary};
+		if (!file) {
+			spdlog::warn("[sdl::CompressedImage] Failed to open {}", filename);
+			return;
+		}
+		std::vector<std::uint8_t> data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+		bool loaded = false;
+		if (data.size() >= Ktx2HeaderSize && std::equal(Ktx2Identifier.begin(), Ktx2Identifier.end(), data.begin())) {
+			loaded = loadKtx2(std::move(data));
+		} else if (data.size() >= DdsHeaderSize && std::memcmp(data.data(), "DDS ", 4) == 0) {
+			loaded = loadDds(std::move(data));
+		} else {
+			spdlog::warn("[sdl::CompressedImage] {} is neither a KTX2 nor a DDS file", filename);
+			return;
+		}
+		if (!loaded) {
+			spdlog::warn("[sdl::CompressedImage] {} failed to be loaded", filename);
+			data_.clear();
+			levels_.clear();
+		}
+	}
+
+	bool CompressedImage::isCompressedFile(std::string_view filename) {
+		auto endsWith = [filename](std::string_view extension) {
+			return filename.size() >= extension.size()
+				&& std::equal(extension.begin(), extension.end(), filename.end() - extension.size(), [](char a, char b) {
+					return a == std::tolower(static_cast<unsigned char>(b));
+				});
+		};
+		return endsWith(".ktx2") || endsWith(".dds");
+	}
+
+	int CompressedImage::getWidth() const noexcept {
+		return levels_.empty() ? 0 : levels_.front().width;
+	}
+
+	int CompressedImage::getHeight() const noexcept {
+		return levels_.empty() ? 0 : levels_.front().height;
+	}
+
+	Size CompressedImage::getSize() const noexcept {
+		return {getWidth(), getHeight()};
+	}
+
+	std::span<const std::uint8_t> CompressedImage::getLevelData(int level) const {
+		const auto& info = levels_[level];
+		return {data_.data() + info.offset, info.size};
+	}
+
+	bool CompressedImage::isFormatSupported() const {
+		auto info = findFormat(format_);
+		if (info == nullptr) {
+			return false;
+		}
+		switch (info->family) {
+			case Family::S3tc: {
+				static const bool supported = isExtensionSupported("GL_EXT_texture_compression_s3tc");
+				return supported;
+			}
+			case Family::Rgtc:
+				// Core since OpenGL 3.0.
+				return true;
+			case Family::Bptc: {
+				static const bool supported = isExtensionSupported("GL_ARB_texture_compression_bptc");
+				return supported;
+			}
+			case Family::Etc2: {
+				static const bool supported = isExtensionSupported("GL_ARB_ES3_compatibility");
+				return supported;
+			}
+			case Family::Astc: {
+				static const bool supported = isExtensionSupported("GL_KHR_texture_compression_astc_ldr");
+				return supported;
+			}
+		}
+		return false;
+	}
+
+	bool CompressedImage::isDecodable() const noexcept {
+		auto info = findFormat(format_);
+		return info != nullptr && (info->family == Family::S3tc || (info->family == Family::Rgtc && !isSignedFormat(format_)));
+	}
+
+	Surface CompressedImage::decode(int level) const {
+		if (!isLoaded() || level < 0 || level >= getLevelCount() || !isDecodable()) {
+			return {};
+		}
+		const auto& info = levels_[level];
+		// Is premultiplied if the pipeline is, i.e. the same as the uploaded compressed data.
+		Surface surface{info.width, info.height};
+		if (!surface.isLoaded()) {
+			return {};
+		}
+
+		auto dst = surface.surface_;
+		SDL_LockSurface(dst);
+		const auto blocksX = (info.width + 3) / 4;
+		const auto blocksY = (info.height + 3) / 4;
+		const auto* block = data_.data() + info.offset;
+		std::uint8_t pixels[16 * 4]{};
+		for (int by = 0; by < blocksY; ++by) {
+			for (int bx = 0; bx < blocksX; ++bx, block += blockBytes_) {
+				decodeBlock(format_, block, pixels);
+				// Blocks at the right and bottom edges may be partial.
+				const int w = std::min(4, info.width - 4 * bx);
+				const int h = std::min(4, info.height - 4 * by);
+				for (int y = 0; y < h; ++y) {
+					auto row = static_cast<std::uint8_t*>(dst->pixels) + (4 * by + y) * dst->pitch + 4 * 4 * bx;
+					std::memcpy(row, pixels + 4 * 4 * y, 4 * w);
+				}
+			}
+		}
+		SDL_UnlockSurface(dst);
+		return surface;
+	}
+
+	bool CompressedImage::loadKtx2(std::vector<std::uint8_t>&& data) {
+		const auto vkFormat = read<std::uint32_t>(data, 12);
+		const auto width = read<std::uint32_t>(data, 20);
+		const auto height = read<std::uint32_t>(data, 24);
+		const auto depth = read<std::uint32_t>(data, 28);
+		const auto layerCount = read<std::uint32_t>(data, 32);
+		const auto faceCount = read<std::uint32_t>(data, 36);
+		const auto levelCount = std::max(read<std::uint32_t>(data, 40), 1u);
+		const auto supercompression = read<std::uint32_t>(data, 44);
+
+		if (supercompression != 0) {
+			spdlog::warn("[sdl::CompressedImage] Supercompressed KTX2 is not supported, scheme: {}", supercompression);
+			return false;
+		}
+		if (depth > 0 || layerCount > 0 || faceCount != 1) {
+			spdlog::warn("[sdl::CompressedImage] Only 2D KTX2 textures are supported");
+			return false;
+		}
+		if (!setFormat(vkFormatToGl(vkFormat))) {
+			spdlog::warn("[sdl::CompressedImage] KTX2 vkFormat {} is not supported", vkFormat);
+			return false;
+		}
+		if (width > MaxSize || height > MaxSize || levelCount > 32) {
+			spdlog::warn("[sdl::CompressedImage] Invalid KTX2 size {}x{} with {} levels", width, height, levelCount);
+			return false;
+		}
+		if (data.size() < Ktx2HeaderSize + levelCount * Ktx2LevelIndexSize) {
+			return false;
+		}
+
+		data_ = std::move(data);
+		if (!addLevels(static_cast<int>(width), static_cast<int>(height), static_cast<int>(levelCount), 0)) {
+			return false;
+		}
+		// The level index has its own offsets, level 0 is the largest.
+		for (std::size_t i = 0; i < levels_.size(); ++i) {
+			const auto offset = read<std::uint64_t>(data_, Ktx2HeaderSize + i * Ktx2LevelIndexSize);
+			const auto length = read<std::uint64_t>(data_, Ktx2HeaderSize + i * Ktx2LevelIndexSize + 8);
+			if (length < levels_[i].size || offset > data_.size() || levels_[i].size > data_.size() - offset) {
+				return false;
+			}
+			levels_[i].offset = static_cast<std::size_t>(offset);
+		}
+		return true;
+	}
+
+	bool CompressedImage::loadDds(std::vector<std::uint8_t>&& data) {
+		const auto flags = read<std::uint32_t>(data, 8);
+		const auto height = read<std::uint32_t>(data, 12);
+		const auto width = read<std::uint32_t>(data, 16);
+		const auto mipMapCount = (flags & DdsMipMapCountFlag) != 0 ? std::max(read<std::uint32_t>(data, 28), 1u) : 1u;
+		const auto code = read<std::uint32_t>(data, 84);
+		if (width > MaxSize || height > MaxSize || mipMapCount > 32) {
+			spdlog::warn("[sdl::CompressedImage] Invalid DDS size {}x{} with {} levels", width, height, mipMapCount);
+			return false;
+		}
+
+		gl::GLenum format{};
+		std::size_t offset = DdsHeaderSize;
+		if (code == fourCC("DX10")) {
+			if (data.size() < DdsHeaderSize + DdsDx10HeaderSize) {
+				return false;
+			}
+			const auto dxgiFormat = read<std::uint32_t>(data, DdsHeaderSize);
+			format = dxgiFormatToGl(dxgiFormat);
+			offset += DdsDx10HeaderSize;
+			if (format == gl::GLenum{}) {
+				spdlog::warn("[sdl::CompressedImage] DDS DXGI format {} is not supported", dxgiFormat);
+			}
+		} else {
+			format = fourCCToGl(code);
+			if (format == gl::GLenum{}) {
+				spdlog::warn("[sdl::CompressedImage] DDS FourCC {:#x} is not supported", code);
+			}
+		}
+		if (!setFormat(format)) {
+			return false;
+		}
+		data_ = std::move(data);
+		return addLevels(static_cast<int>(width), static_cast<int>(height), static_cast<int>(mipMapCount), offset);
+	}
+
+	bool CompressedImage::setFormat(gl::GLenum format) {
+		auto info = findFormat(format);
+		if (info == nullptr) {
+			return false;
+		}
+		format_ = info->format;
+		blockBytes_ = info->blockBytes;
+		srgb_ = info->srgb;
+		return true;
+	}
+
+	bool CompressedImage::addLevels(int width, int height, int count, std::size_t offset) {
+		if (width <= 0 || height <= 0 || offset > data_.size()) {
+			return false;
+		}
+		levels_.clear();
+		for (int i = 0; i < count; ++i) {
+			const auto size = static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes_;
+			if (size > data_.size() - offset) {
+				// Truncated, keep the complete levels.
+				break;
+			}
+			levels_.push_back({width, height, offset, size});
+			offset += size;
+			width = std::max(width / 2, 1);
+			height = std::max(height / 2, 1);
+		}
+		return !levels_.empty();
+	}
+
+}
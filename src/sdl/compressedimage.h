@@ -0,0 +1,94 @@
+#ifndef CPPSDL2_SDL_COMPRESSEDIMAGE_H
+#define CPPSDL2_SDL_COMPRESSEDIMAGE_H
+
+#include "opengl.h"
+#include "rect.h"
+#include "surface.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sdl {
+
+	// A block compressed 2D image with its mip chain, loaded from a KTX2 or DDS file and
+	// uploaded as is with glCompressedTexImage2D. Supports BC1-BC7, ETC2 and ASTC 4x4.
+	// Supercompressed KTX2 files (BasisLZ, zstd) are not supported. The pixels are not
+	// premultiplied by the color pipeline, i.e. must be exported premultiplied if used.
+	class CompressedImage {
+	public:
+		struct Level {
+			int width;
+			int height;
+			std::size_t offset;
+			std::size_t size;
+		};
+
+		CompressedImage() = default;
+
+		// Load a KTX2 or DDS file, depending on the file header.
+		explicit CompressedImage(const std::string& filename);
+
+		// Return true if the filename has the extension .ktx2 or .dds.
+		static bool isCompressedFile(std::string_view filename);
+
+		bool isLoaded() const noexcept {
+			return !levels_.empty();
+		}
+
+		// The compressed internal format, e.g. GL_COMPRESSED_RGBA_BPTC_UNORM.
+		gl::GLenum getFormat() const noexcept {
+			return format_;
+		}
+
+		bool isSrgb() const noexcept {
+			return srgb_;
+		}
+
+		int getWidth() const noexcept;
+
+		int getHeight() const noexcept;
+
+		Size getSize() const noexcept;
+
+		int getLevelCount() const noexcept {
+			return static_cast<int>(levels_.size());
+		}
+
+		const Level& getLevel(int level) const {
+			return levels_[level];
+		}
+
+		std::span<const std::uint8_t> getLevelData(int level) const;
+
+		// Return true if the current OpenGL context supports the format.
+		bool isFormatSupported() const;
+
+		// Return true if decode() supports the format, i.e. BC1-BC5 except signed BC4 and BC5.
+		bool isDecodable() const noexcept;
+
+		// Decode the level into a RGBA32 surface, e.g. if the driver does not support the format.
+		// Return an empty surface if not decodable.
+		Surface decode(int level = 0) const;
+
+	private:
+		bool loadKtx2(std::vector<std::uint8_t>&& data);
+
+		bool loadDds(std::vector<std::uint8_t>&& data);
+
+		bool setFormat(gl::GLenum format);
+
+		bool addLevels(int width, int height, int count, std::size_t offset);
+
+		std::vector<std::uint8_t> data_;
+		std::vector<Level> levels_;
+		gl::GLenum format_{};
+		int blockBytes_ = 0;
+		bool srgb_ = false;
+	};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include "filewatcher.h"
+
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+
+namespace sdl {
+
+	namespace {
+
+		std::filesystem::file_time_type lastWriteTime(const std::filesystem::path& path) {
+			std::error_code error;
+			auto time = std::filesystem::last_write_time(path, error);
+			return error ? std::filesystem::file_time_type{} : time;
+		}
+
+	}
+
+	FileWatcher::FileWatcher() {
+#ifdef __linux__
+		inotify_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotify_ < 0) {
+			spdlog::warn("[sdl::FileWatcher] inotify not available, falls back to polling");
+		}
+#endif
+	}
+
+	FileWatcher::~FileWatcher() {
+#ifdef __linux__
+		if (inotify_ >= 0) {
+			close(inotify_);
+		}
+#endif
+	}
+
+	bool FileWatcher::add(const std::string& file) {
+		std::error_code error;
+		auto path = std::filesystem::canonical(file, error);
+		if (error) {
+			spdlog::warn("[sdl::FileWatcher] Failed to watch {}: {}", file, error.message());
+			return false;
+		}
+		int watch = -1;
+#ifdef __linux__
+		if (inotify_ >= 0) {
+			// Watch the directory, editors often save by replacing the file. Not IN_CREATE, the new
+			// file is empty until IN_CLOSE_WRITE, and atomic replacement gives IN_MOVED_TO.
+			watch = inotify_add_watch(inotify_, path.parent_path().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (watch < 0) {
+				spdlog::warn("[sdl::FileWatcher] Failed to add inotify watch for {}", file);
+			}
+		}
+#endif
+		files_.push_back({path, lastWriteTime(path), watch});
+		return true;
+	}
+
+	bool FileWatcher::poll() {
+#ifdef __linux__
+		if (inotify_ >= 0) {
+			bool changed = false;
+			alignas(inotify_event) std::array<char, 4096> buffer;
+			while (true) {
+				auto length = read(inotify_, buffer.data(), buffer.size());
+				if (length <= 0) {
+					break;
+				}
+				for (auto ptr = buffer.data(); ptr < buffer.data() + length;) {
+					const auto& event = *reinterpret_cast<const inotify_event*>(ptr);
+					if (event.len > 0) {
+						std::string_view name{event.name};
+						changed = changed || std::ranges::any_of(files_, [&](const File& file) {
+							return file.watch == event.wd && file.path.filename() == name;
+						});
+					}
+					ptr += sizeof(inotify_event) + event.len;
+				}
+			}
+			// Files without a watch are polled.
+			return pollLastWrite() || changed;
+		}
+#endif
+		return pollLastWrite();
+	}
+
+	bool FileWatcher::pollLastWrite() {
+		bool changed = false;
+		for (auto& file : files_) {
+			if (file.watch >= 0) {
+				continue;
+			}
+			if (auto time = lastWriteTime(file.path); time != file.lastWrite) {
+				file.lastWrite = time;
+				changed = true;
+			}
+		}
+		return changed;
+	}
+
+	void FileWatcher::clear() {
+#ifdef __linux__
+		for (const auto& file : files_) {
+			if (file.watch >= 0) {
+				// Several files may share the directory watch, removing it twice fails silently.
+				inotify_rm_watch(inotify_, file.watch);
+			}
+		}
+#endif
+		files_.clear();
+	}
+
+}
@@ -0,0 +1,43 @@
+#ifndef CPPSDL2_SDL_FILEWATCHER_H
+#define CPPSDL2_SDL_FILEWATCHER_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace sdl {
+
+	// Watch files for changes without blocking, i.e. meant to be polled once per frame.
+	// Uses inotify on Linux, else compares the last write time of the files.
+	class FileWatcher {
+	public:
+		FileWatcher();
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		// Start to watch the file. Return false if the file does not exist.
+		bool add(const std::string& file);
+
+		// Return true if any of the watched files changed since the last call.
+		bool poll();
+
+		void clear();
+
+	private:
+		struct File {
+			std::filesystem::path path;
+			std::filesystem::file_time_type lastWrite;
+			int watch;
+		};
+
+		bool pollLastWrite();
+
+		std::vector<File> files_;
+		int inotify_ = -1;
+	};
+
+}
+
+#endif
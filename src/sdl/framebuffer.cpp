@@ -51,4 +51,38 @@ namespace sdl {
 		return frameBuffer_ != 0;
 	}
 
+	void FrameBuffer::attachTexture(const Texture& texture) {
+		if (!isValid() || !texture.isValid()) {
+			spdlog::warn("[sdl::FrameBuffer] Failed to attach texture, frame buffer and texture must be generated first");
+			return;
+		}
+		gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, frameBuffer_);
+		gl::glFramebufferTexture2D(gl::GL_FRAMEBUFFER, gl::GL_COLOR_ATTACHMENT0, gl::GL_TEXTURE_2D, texture, 0);
+	}
+
+	void FrameBuffer::attachRenderBuffer(const RenderBuffer& renderBuffer, gl::GLenum attachment) {
+		if (!isValid() || !renderBuffer.isValid()) {
+			spdlog::warn("[sdl::FrameBuffer] Failed to attach render buffer, frame buffer and render buffer must be generated first");
+			return;
+		}
+		gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, frameBuffer_);
+		gl::glFramebufferRenderbuffer(gl::GL_FRAMEBUFFER, attachment, gl::GL_RENDERBUFFER, renderBuffer);
+	}
+
+	void FrameBuffer::blit(gl::GLuint destination, int width, int height) const {
+		gl::glBindFramebuffer(gl::GL_READ_FRAMEBUFFER, frameBuffer_);
+		gl::glBindFramebuffer(gl::GL_DRAW_FRAMEBUFFER, destination);
+		gl::glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, gl::GL_COLOR_BUFFER_BIT, gl::GL_NEAREST);
+		gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, destination);
+	}
+
+	bool FrameBuffer::checkStatus() const {
+		auto status = gl::glCheckFramebufferStatus(gl::GL_FRAMEBUFFER);
+		if (status != gl::GL_FRAMEBUFFER_COMPLETE) {
+			spdlog::error("[sdl::FrameBuffer] Frame buffer {} not complete, status: {}", frameBuffer_, static_cast<unsigned int>(status));
+			return false;
+		}
+		return true;
+	}
+
 }
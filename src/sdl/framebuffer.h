@@ -2,6 +2,8 @@
 #define CPPSDL2_SDL_FRAMEBUFFER_H
 
 #include "opengl.h"
+#include "renderbuffer.h"
+#include "texture.h"
 
 namespace sdl {
 
@@ -26,6 +28,20 @@ namespace sdl {
 		
 		bool isValid() const noexcept;
 
+		// Attach the texture as the color buffer. The frame buffer is binded.
+		void attachTexture(const Texture& texture);
+
+		// Attach the render buffer, e.g. a multisampled color buffer. The frame buffer is binded.
+		void attachRenderBuffer(const RenderBuffer& renderBuffer, gl::GLenum attachment = gl::GL_COLOR_ATTACHMENT0);
+
+		// Copy the color buffer to the destination frame buffer, which resolves a multisampled
+		// buffer. Use 0 as destination for the default frame buffer. Binds the destination
+		// frame buffer afterwards.
+		void blit(gl::GLuint destination, int width, int height) const;
+
+		// Return true if the binded frame buffer is complete, else the status is logged.
+		bool checkStatus() const;
+
 		friend bool operator==(const FrameBuffer& left, const FrameBuffer& right) noexcept;
 		
 		friend bool operator!=(const FrameBuffer& left, const FrameBuffer& right) noexcept;
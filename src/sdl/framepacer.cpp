@@ -0,0 +1,63 @@
+#include "framepacer.h"
+
+#include <SDL.h>
+#include <spdlog/spdlog.h>
+
+#include <thread>
+
+namespace sdl {
+
+	std::chrono::nanoseconds FramePacer::getFrameTime() const noexcept {
+		int fps = idle_ && idleFps_ > 0 ? idleFps_ : targetFps_;
+		if (fps <= 0) {
+			return std::chrono::nanoseconds::zero();
+		}
+		return std::chrono::nanoseconds{std::chrono::seconds{1}} / fps;
+	}
+
+	void FramePacer::wait() {
+		auto frameTime = getFrameTime();
+		if (frameTime == std::chrono::nanoseconds::zero()) {
+			return;
+		}
+
+		auto now = PacerClock::now();
+		deadline_ += frameTime;
+		if (deadline_ < now - frameTime || deadline_ > now + frameTime) {
+			// Too late or the frame rate changed, start over instead of catching up.
+			deadline_ = now;
+			return;
+		}
+
+		if (auto sleepUntil = deadline_ - spinTime_; now < sleepUntil) {
+			std::this_thread::sleep_until(sleepUntil);
+		}
+		while (PacerClock::now() < deadline_) {
+			std::this_thread::yield();
+		}
+	}
+
+	VSync FramePacer::setSwapInterval(VSync vsync) {
+		switch (vsync) {
+			case VSync::Adaptive:
+				if (SDL_GL_SetSwapInterval(-1) == 0) {
+					return VSync::Adaptive;
+				}
+				spdlog::info("[sdl::FramePacer] Adaptive VSync not supported, uses VSync: {}", SDL_GetError());
+				[[fallthrough]];
+			case VSync::On:
+				if (SDL_GL_SetSwapInterval(1) == 0) {
+					return VSync::On;
+				}
+				spdlog::warn("[sdl::FramePacer] Unable to set VSync: {}", SDL_GetError());
+				return VSync::Off;
+			case VSync::Off:
+				if (SDL_GL_SetSwapInterval(0) != 0) {
+					spdlog::warn("[sdl::FramePacer] Unable to turn off VSync: {}", SDL_GetError());
+				}
+				break;
+		}
+		return VSync::Off;
+	}
+
+}
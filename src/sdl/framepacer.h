@@ -0,0 +1,93 @@
+#ifndef CPPSDL2_SDL_FRAMEPACER_H
+#define CPPSDL2_SDL_FRAMEPACER_H
+
+#include <chrono>
+
+namespace sdl {
+
+	enum class VSync {
+		Off,
+		On,
+		// Late swaps tear instead of waiting a whole frame, falls back to On if not supported.
+		Adaptive
+	};
+
+	// Waits for the deadline of the next frame, using sleep for the coarse part and
+	// spinning the last part in order to hit the deadline precisely.
+	class FramePacer {
+	public:
+		using PacerClock = std::chrono::steady_clock;
+
+		FramePacer() = default;
+
+		// Zero means no limit, which is the default.
+		void setTargetFps(int fps) noexcept;
+
+		int getTargetFps() const noexcept;
+
+		// The frame rate used when idle, e.g. when the window is hidden or not in focus.
+		// Zero means the same as the target fps.
+		void setIdleFps(int fps) noexcept;
+
+		int getIdleFps() const noexcept;
+
+		void setIdle(bool idle) noexcept;
+
+		bool isIdle() const noexcept;
+
+		// The time before the deadline spent spinning instead of sleeping.
+		void setSpinTime(const std::chrono::nanoseconds& spinTime) noexcept;
+
+		const std::chrono::nanoseconds& getSpinTime() const noexcept;
+
+		// Block until the deadline for the current frame. Returns directly if no frame rate is set.
+		void wait();
+
+		// Set the swap interval for the current OpenGL context. Return the VSync mode actually used.
+		static VSync setSwapInterval(VSync vsync);
+
+	private:
+		std::chrono::nanoseconds getFrameTime() const noexcept;
+
+		PacerClock::time_point deadline_{};
+		std::chrono::nanoseconds spinTime_{std::chrono::milliseconds{2}};
+		int targetFps_ = 0;
+		int idleFps_ = 0;
+		bool idle_ = false;
+	};
+
+	inline void FramePacer::setTargetFps(int fps) noexcept {
+		targetFps_ = fps > 0 ? fps : 0;
+	}
+
+	inline int FramePacer::getTargetFps() const noexcept {
+		return targetFps_;
+	}
+
+	inline void FramePacer::setIdleFps(int fps) noexcept {
+		idleFps_ = fps > 0 ? fps : 0;
+	}
+
+	inline int FramePacer::getIdleFps() const noexcept {
+		return idleFps_;
+	}
+
+	inline void FramePacer::setIdle(bool idle) noexcept {
+		idle_ = idle;
+	}
+
+	inline bool FramePacer::isIdle() const noexcept {
+		return idle_;
+	}
+
+	inline void FramePacer::setSpinTime(const std::chrono::nanoseconds& spinTime) noexcept {
+		spinTime_ = spinTime;
+	}
+
+	inline const std::chrono::nanoseconds& FramePacer::getSpinTime() const noexcept {
+		return spinTime_;
+	}
+
+}
+
+#endif
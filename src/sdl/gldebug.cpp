@@ -0,0 +1,154 @@
+#include "gldebug.h"
+
+#include <spdlog/spdlog.h>
+
+#ifdef CPPSDL2_GL_DEBUG
+#include <glbinding/glbinding.h>
+#include <glbinding/FunctionCall.h>
+#include <glbinding/AbstractFunction.h>
+#endif
+
+namespace sdl::gldebug {
+
+#ifdef CPPSDL2_GL_DEBUG
+	namespace {
+
+		Severity minSeverity = Severity::Low;
+		int sampleInterval = 60;
+		int frame = 0;
+		bool callbackActive = false;
+
+		const char* errorString(gl::GLenum error) {
+			switch (error) {
+				case gl::GL_NO_ERROR:                          return "GL_NO_ERROR";
+				case gl::GL_INVALID_ENUM:                      return "GL_INVALID_ENUM";
+				case gl::GL_INVALID_VALUE:                     return "GL_INVALID_VALUE";
+				case gl::GL_INVALID_OPERATION:                 return "GL_INVALID_OPERATION";
+				case gl::GL_STACK_OVERFLOW:                    return "GL_STACK_OVERFLOW";
+				case gl::GL_STACK_UNDERFLOW:                   return "GL_STACK_UNDERFLOW";
+				case gl::GL_OUT_OF_MEMORY:                     return "GL_OUT_OF_MEMORY";
+				case gl::GL_INVALID_FRAMEBUFFER_OPERATION:     return "GL_INVALID_FRAMEBUFFER_OPERATION";
+				case gl::GL_TABLE_TOO_LARGE:                   return "GL_TABLE_TOO_LARGE";
+			}
+			return "Unknown GL error code";
+		}
+
+		const char* typeString(gl::GLenum type) {
+			switch (type) {
+				case gl::GL_DEBUG_TYPE_ERROR:                  return "Error";
+				case gl::GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:    return "Deprecated";
+				case gl::GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:     return "Undefined behavior";
+				case gl::GL_DEBUG_TYPE_PORTABILITY:            return "Portability";
+				case gl::GL_DEBUG_TYPE_PERFORMANCE:            return "Performance";
+			}
+			return "Other";
+		}
+
+		void messageCallback(gl::GLenum source, gl::GLenum type, gl::GLuint id, gl::GLenum severity,
+			gl::GLsizei length, const gl::GLchar* message, const void* userParam) {
+
+			switch (severity) {
+				case gl::GL_DEBUG_SEVERITY_HIGH:
+					spdlog::error("[sdl::gldebug] {} {}: {}", typeString(type), id, message);
+					break;
+				case gl::GL_DEBUG_SEVERITY_MEDIUM:
+					spdlog::warn("[sdl::gldebug] {} {}: {}", typeString(type), id, message);
+					break;
+				case gl::GL_DEBUG_SEVERITY_LOW:
+					spdlog::info("[sdl::gldebug] {} {}: {}", typeString(type), id, message);
+					break;
+				default:
+					spdlog::debug("[sdl::gldebug] {} {}: {}", typeString(type), id, message);
+					break;
+			}
+		}
+
+		void applySeverityFilter() {
+			constexpr gl::GLenum severities[] = {
+				gl::GL_DEBUG_SEVERITY_NOTIFICATION, gl::GL_DEBUG_SEVERITY_LOW, gl::GL_DEBUG_SEVERITY_MEDIUM, gl::GL_DEBUG_SEVERITY_HIGH
+			};
+			for (int i = 0; i < 4; ++i) {
+				bool enabled = i >= static_cast<int>(minSeverity);
+				gl::glDebugMessageControl(gl::GL_DONT_CARE, gl::GL_DONT_CARE, severities[i], 0, nullptr, enabled ? gl::GL_TRUE : gl::GL_FALSE);
+			}
+		}
+
+		bool isDebugContext() {
+			gl::GLint flags = 0;
+			gl::glGetIntegerv(gl::GL_CONTEXT_FLAGS, &flags);
+			return (static_cast<unsigned int>(flags) & static_cast<unsigned int>(gl::GL_CONTEXT_FLAG_DEBUG_BIT)) != 0;
+		}
+
+		void checkErrors(const char* where) {
+			for (auto error = gl::glGetError(); error != gl::GL_NO_ERROR; error = gl::glGetError()) {
+				spdlog::warn("[sdl::gldebug] {}={} {}", errorString(error), static_cast<int>(error), where);
+			}
+		}
+
+	}
+
+	void setup() {
+		frame = 0;
+		callbackActive = isDebugContext() && isExtensionSupported("GL_KHR_debug");
+		if (callbackActive) {
+			gl::glEnable(gl::GL_DEBUG_OUTPUT);
+			gl::glDebugMessageCallback(messageCallback, nullptr);
+			applySeverityFilter();
+			spdlog::info("[sdl::gldebug] Using KHR_debug message callback");
+		} else {
+			spdlog::info("[sdl::gldebug] KHR_debug not available, sampling glGetError every {} frames", sampleInterval);
+		}
+	}
+
+	bool isCallbackActive() {
+		return callbackActive;
+	}
+
+	void setMinSeverity(Severity severity) {
+		minSeverity = severity;
+		if (callbackActive) {
+			applySeverityFilter();
+		}
+	}
+
+	void setSampleInterval(int frames) {
+		sampleInterval = frames > 0 ? frames : 0;
+	}
+
+	void setCheckEveryCall(bool check) {
+		if (check) {
+			glbinding::setCallbackMaskExcept(glbinding::CallbackMask::After, {"glGetError"});
+			glbinding::setAfterCallback([](const glbinding::FunctionCall& call) {
+				checkErrors(call.function->name());
+			});
+		} else {
+			glbinding::setCallbackMask(glbinding::CallbackMask::None);
+		}
+	}
+
+	void newFrame() {
+		if (callbackActive || sampleInterval == 0) {
+			return;
+		}
+		if (++frame >= sampleInterval) {
+			frame = 0;
+			checkErrors("during the last frames");
+		}
+	}
+#else
+	void setup() {}
+
+	bool isCallbackActive() {
+		return false;
+	}
+
+	void setMinSeverity(Severity severity) {}
+
+	void setSampleInterval(int frames) {}
+
+	void setCheckEveryCall(bool check) {}
+
+	void newFrame() {}
+#endif
+
+}
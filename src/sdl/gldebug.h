@@ -0,0 +1,48 @@
+#ifndef CPPSDL2_SDL_GLDEBUG_H
+#define CPPSDL2_SDL_GLDEBUG_H
+
+#include "opengl.h"
+
+// The OpenGL error checking is compiled in only when CPPSDL2_GL_DEBUG is defined, by
+// default in CMake debug builds, otherwise all functions do nothing.
+namespace sdl::gldebug {
+
+	enum class Severity {
+		Notification,
+		Low,
+		Medium,
+		High
+	};
+
+	constexpr bool isEnabled() noexcept {
+#ifdef CPPSDL2_GL_DEBUG
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Install the KHR_debug message callback, if supported by the context, else the errors
+	// are sampled by newFrame(). Called by the window after the OpenGL context is created.
+	void setup();
+
+	// Return true if the KHR_debug message callback is used.
+	bool isCallbackActive();
+
+	// Messages below the severity are filtered out by the driver. Default is Low.
+	void setMinSeverity(Severity severity);
+
+	// Check glGetError() every n:th frame, only used without the KHR_debug callback.
+	// Zero turns it off. Default is every 60:th frame.
+	void setSampleInterval(int frames);
+
+	// Check glGetError() after every OpenGL call, in order to find the failing call.
+	// Serializes the pipeline, use only while hunting a specific error.
+	void setCheckEveryCall(bool check);
+
+	// Called once each frame on the OpenGL thread.
+	void newFrame();
+
+}
+
+#endif
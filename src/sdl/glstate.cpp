@@ -0,0 +1,197 @@
+#include "glstate.h"
+#include "renderstats.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace sdl::glstate {
+
+	namespace {
+
+		constexpr gl::GLuint Unknown = std::numeric_limits<gl::GLuint>::max();
+		constexpr int TextureUnits = 32;
+		constexpr std::array<gl::GLenum, 6> CachedCaps{
+			gl::GL_BLEND, gl::GL_DEPTH_TEST, gl::GL_SCISSOR_TEST, gl::GL_CULL_FACE, gl::GL_PROGRAM_POINT_SIZE, gl::GL_FRAMEBUFFER_SRGB
+		};
+
+		enum class Cap : char {
+			Unknown,
+			Enabled,
+			Disabled
+		};
+
+		struct State {
+			gl::GLuint program = Unknown;
+			gl::GLuint vertexArray = Unknown;
+			gl::GLuint arrayBuffer = Unknown;
+			// Part of the vertex array state.
+			gl::GLuint elementBuffer = Unknown;
+			int activeUnit = -1;
+			std::array<gl::GLuint, TextureUnits> textures;
+			std::array<Cap, CachedCaps.size()> caps;
+
+			State() {
+				textures.fill(Unknown);
+				caps.fill(Cap::Unknown);
+			}
+		};
+
+		State& state() {
+			thread_local State state;
+			return state;
+		}
+
+		int capIndex(gl::GLenum cap) {
+			auto it = std::find(CachedCaps.begin(), CachedCaps.end(), cap);
+			return it == CachedCaps.end() ? -1 : static_cast<int>(it - CachedCaps.begin());
+		}
+
+		int unitIndex(gl::GLenum unit) {
+			int index = static_cast<int>(unit) - static_cast<int>(gl::GL_TEXTURE0);
+			return index >= 0 && index < TextureUnits ? index : -1;
+		}
+
+		int activeUnit() {
+			auto& current = state();
+			if (current.activeUnit < 0) {
+				gl::GLint unit = 0;
+				gl::glGetIntegerv(gl::GL_ACTIVE_TEXTURE, &unit);
+				current.activeUnit = unitIndex(static_cast<gl::GLenum>(unit));
+			}
+			return current.activeUnit;
+		}
+
+		void forget(gl::GLuint& cached, gl::GLuint id) {
+			if (cached == id) {
+				cached = Unknown;
+			}
+		}
+
+	}
+
+	void useProgram(gl::GLuint program) {
+		if (auto& current = state(); current.program != program) {
+			current.program = program;
+			gl::glUseProgram(program);
+			++renderstats::current().programSwitches;
+		}
+	}
+
+	void bindVertexArray(gl::GLuint vertexArray) {
+		if (auto& current = state(); current.vertexArray != vertexArray) {
+			current.vertexArray = vertexArray;
+			current.elementBuffer = Unknown;
+			gl::glBindVertexArray(vertexArray);
+			++renderstats::current().vertexArrayBinds;
+		}
+	}
+
+	void bindBuffer(gl::GLenum target, gl::GLuint buffer) {
+		auto& current = state();
+		gl::GLuint* cached = nullptr;
+		if (target == gl::GL_ARRAY_BUFFER) {
+			cached = &current.arrayBuffer;
+		} else if (target == gl::GL_ELEMENT_ARRAY_BUFFER) {
+			cached = &current.elementBuffer;
+		}
+		if (cached == nullptr || *cached != buffer) {
+			if (cached) {
+				*cached = buffer;
+			}
+			gl::glBindBuffer(target, buffer);
+		}
+	}
+
+	void activeTexture(gl::GLenum unit) {
+		if (auto& current = state(); current.activeUnit < 0 || current.activeUnit != unitIndex(unit)) {
+			current.activeUnit = unitIndex(unit);
+			gl::glActiveTexture(unit);
+		}
+	}
+
+	void bindTexture(gl::GLuint texture) {
+		int unit = activeUnit();
+		if (unit < 0) {
+			gl::glBindTexture(gl::GL_TEXTURE_2D, texture);
+			++renderstats::current().textureBinds;
+			return;
+		}
+		if (auto& cached = state().textures[unit]; cached != texture) {
+			cached = texture;
+			gl::glBindTexture(gl::GL_TEXTURE_2D, texture);
+			++renderstats::current().textureBinds;
+		}
+	}
+
+	void setEnabled(gl::GLenum cap, bool enabled) {
+		auto value = enabled ? Cap::Enabled : Cap::Disabled;
+		if (int index = capIndex(cap); index >= 0) {
+			auto& cached = state().caps[index];
+			if (cached == value) {
+				return;
+			}
+			cached = value;
+		}
+		if (enabled) {
+			gl::glEnable(cap);
+		} else {
+			gl::glDisable(cap);
+		}
+	}
+
+	void invalidate() {
+		state() = State{};
+	}
+
+	void forgetProgram(gl::GLuint program) {
+		forget(state().program, program);
+	}
+
+	void forgetVertexArray(gl::GLuint vertexArray) {
+		auto& current = state();
+		if (current.vertexArray == vertexArray) {
+			current.vertexArray = Unknown;
+			current.elementBuffer = Unknown;
+		}
+	}
+
+	void forgetBuffer(gl::GLuint buffer) {
+		auto& current = state();
+		forget(current.arrayBuffer, buffer);
+		forget(current.elementBuffer, buffer);
+	}
+
+	void forgetTexture(gl::GLuint texture) {
+		for (auto& cached : state().textures) {
+			forget(cached, texture);
+		}
+	}
+
+	ScopedState::ScopedState() {
+		auto& current = state();
+		int unit = activeUnit();
+		activeTexture_ = static_cast<gl::GLenum>(static_cast<int>(gl::GL_TEXTURE0) + std::max(unit, 0));
+		if (unit < 0 || current.textures[unit] == Unknown) {
+			gl::GLint texture = 0;
+			gl::glGetIntegerv(gl::GL_TEXTURE_BINDING_2D, &texture);
+			texture_ = static_cast<gl::GLuint>(texture);
+		} else {
+			texture_ = current.textures[unit];
+		}
+
+		auto& point = current.caps[capIndex(gl::GL_PROGRAM_POINT_SIZE)];
+		if (point == Cap::Unknown) {
+			gl::GLboolean enabled = gl::GL_FALSE;
+			gl::glGetBooleanv(gl::GL_PROGRAM_POINT_SIZE, &enabled);
+			point = enabled == gl::GL_TRUE ? Cap::Enabled : Cap::Disabled;
+		}
+		pointSize_ = point == Cap::Enabled;
+	}
+
+	ScopedState::~ScopedState() {
+		bindTexture(texture_);
+		activeTexture(activeTexture_);
+		setEnabled(gl::GL_PROGRAM_POINT_SIZE, pointSize_);
+	}
+
+}
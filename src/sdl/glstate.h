@@ -0,0 +1,56 @@
+#ifndef CPPSDL2_SDL_GLSTATE_H
+#define CPPSDL2_SDL_GLSTATE_H
+
+#include "opengl.h"
+
+#include <array>
+
+// Cache of the OpenGL binding state, in order to skip redundant gl calls. Each thread
+// has its own cache, i.e. the cache follows the thread the OpenGL context is current on.
+// Code changing the state outside the cache, e.g. ImGui, must call invalidate() afterwards.
+namespace sdl::glstate {
+
+	void useProgram(gl::GLuint program);
+
+	void bindVertexArray(gl::GLuint vertexArray);
+
+	// Only GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are cached, other targets are passed through.
+	void bindBuffer(gl::GLenum target, gl::GLuint buffer);
+
+	void activeTexture(gl::GLenum unit);
+
+	// Bind the texture to GL_TEXTURE_2D on the active texture unit.
+	void bindTexture(gl::GLuint texture);
+
+	// Only GL_BLEND, GL_DEPTH_TEST, GL_SCISSOR_TEST, GL_CULL_FACE, GL_PROGRAM_POINT_SIZE and
+	// GL_FRAMEBUFFER_SRGB are cached, other capabilities are passed through.
+	void setEnabled(gl::GLenum cap, bool enabled);
+
+	// Forget all cached state, the next call of each kind is issued.
+	void invalidate();
+
+	// Called when an object is deleted, in order to not skip a bind of a new object reusing the id.
+	void forgetProgram(gl::GLuint program);
+	void forgetVertexArray(gl::GLuint vertexArray);
+	void forgetBuffer(gl::GLuint buffer);
+	void forgetTexture(gl::GLuint texture);
+
+	// Saves the active texture unit, its texture and GL_PROGRAM_POINT_SIZE, restored when
+	// destructed. State is only queried from OpenGL if not already known by the cache.
+	class ScopedState {
+	public:
+		ScopedState();
+		~ScopedState();
+
+		ScopedState(const ScopedState&) = delete;
+		ScopedState& operator=(const ScopedState&) = delete;
+
+	private:
+		gl::GLenum activeTexture_;
+		gl::GLuint texture_;
+		bool pointSize_;
+	};
+
+}
+
+#endif
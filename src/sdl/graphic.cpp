@@ -1,4 +1,7 @@
 #include "graphic.h"
+#include "colorpipeline.h"
+#include "glstate.h"
+#include "profiler.h"
 
 #include <glm/gtx/rotate_vector.hpp>
 #include <glm/gtx/component_wise.hpp>
@@ -6,33 +9,6 @@
 
 #include <array>
 
-namespace {
-
-	struct GlScopedState {
-		GlScopedState() {
-			gl::glGetIntegerv(gl::GL_TEXTURE_BINDING_2D, &texture);
-			gl::glGetIntegerv(gl::GL_ACTIVE_TEXTURE, &activeTexture);
-			gl::glGetBooleanv(gl::GL_PROGRAM_POINT_SIZE, &point);
-		}
-
-		~GlScopedState() {
-			gl::glBindTexture(gl::GL_TEXTURE_2D, texture);
-			gl::glActiveTexture(activeTexture);
-
-			if (point) {
-				gl::glEnable(gl::GL_PROGRAM_POINT_SIZE);
-			} else {
-				gl::glDisable(gl::GL_PROGRAM_POINT_SIZE);
-			}
-		}
-
-		gl::GLint texture;
-		gl::GLenum activeTexture;
-		gl::GLboolean point;
-	};
-
-}
-
 namespace sdl::graphic {
 	
 	glm::vec2 getHexagonCorner(int nbr, float startAngle) {
@@ -179,10 +155,12 @@ namespace sdl {
 		if (batch_.isEmpty()) {
 			return;
 		}
+		SDL_PROFILE_SCOPE("Graphic::upload");
+		SDL_PROFILE_GPU_SCOPE("Graphic::upload");
 		
-		GlScopedState currentState;
+		glstate::ScopedState currentState;
 
-		gl::glActiveTexture(gl::GL_TEXTURE1);
+		glstate::activeTexture(gl::GL_TEXTURE1);
 
 		auto index = currentMatrixIndex_;
 		currentMatrixIndex_ = -1;
@@ -197,6 +175,45 @@ namespace sdl {
 		currentMatrixIndex_ = index;
 	}
 
+	void Graphic::upload(sdl::ShaderPermutations& shaders) {
+		if (batch_.isEmpty()) {
+			return;
+		}
+		SDL_PROFILE_SCOPE("Graphic::upload");
+		SDL_PROFILE_GPU_SCOPE("Graphic::upload");
+
+		glstate::ScopedState currentState;
+
+		glstate::activeTexture(gl::GL_TEXTURE1);
+
+		auto index = currentMatrixIndex_;
+		const auto pipelineFeatures = colorpipeline::getShaderFeatures();
+		sdl::Shader* current = nullptr;
+		bool uploaded = false;
+		for (const auto& batchData : batches_) {
+			auto features = ShaderFeatures::VertexColor | ShaderFeatures::Textured | shaderFeatures_ | pipelineFeatures;
+			if (!batchData.texture) {
+				// Sdf only applies to the texture sample.
+				features = features & (ShaderFeatures::VertexColor | ShaderFeatures::AlphaTest | ShaderFeatures::LinearColor | ShaderFeatures::PremultipliedAlpha);
+			}
+			auto& shader = shaders.get(features);
+			if (&shader != current) {
+				current = &shader;
+				shader.useProgram();
+				if (!uploaded) {
+					uploaded = true;
+					bind(shader);
+					batch_.uploadToGraphicCard();
+				}
+				// Uniforms belong to the program, i.e. the matrix must be set again.
+				currentMatrixIndex_ = -1;
+			}
+			draw(shader, batchData);
+		}
+
+		currentMatrixIndex_ = index;
+	}
+
 	void Graphic::addPixel(const glm::vec2& point, Color color, float size) {
 		batch_.startBatchView();
 		batch_.startAdding();
@@ -266,15 +283,17 @@ namespace sdl {
 	}
 
 	void Graphic::draw(sdl::Shader& shader, const BatchData& batchData) {
+		auto& stats = renderstats::current();
 		if (const auto& texture = batchData.texture; texture) {
 			shader.setTextureId(1);
-			gl::glBindTexture(gl::GL_TEXTURE_2D, texture);
+			glstate::bindTexture(texture);
 		} else {
 			shader.setTextureId(-1);
 		}
 		if (currentMatrixIndex_ != batchData.matrixIndex) {
 			currentMatrixIndex_ = batchData.matrixIndex;
 			shader.setMatrix(matrixes_[currentMatrixIndex_].matrix);
+			++stats.matrixUploads;
 		}
 		batch_.draw(batchData.batchView);
 	}
@@ -295,9 +314,11 @@ namespace sdl {
 			if (getMatrixIndex() == backData.matrixIndex
 				&& backData.texture == texture
 				&& backData.batchView.tryMerge(batchView)) {
+				renderstats::addBatchView(true);
 				return;
 			}
 		}
+		renderstats::addBatchView(false);
 
 		batches_.emplace_back(BatchData{batchView, texture, getMatrixIndex()});
 		dirty_ = false;
@@ -8,10 +8,12 @@
 #include "vertexarrayobject.h"
 #include "vertexbufferobject.h"
 #include "shader.h"
+#include "shaderpermutations.h"
 
 #include <glm/gtc/constants.hpp>
 
 #include <array>
+#include <span>
 #include <type_traits>
 
 namespace sdl::graphic {
@@ -99,8 +101,25 @@ namespace sdl {
 
 		void addHexagon(const glm::vec2& center, float innerRadius, float outerRadius, Color color, float startAngle = 0);
 
+		// Add size quads. The four vertexes per quad (lower left, lower right, upper right, upper left)
+		// are written in place by writeVertexes, i.e. no function call per quad.
+		void addQuads(gl::GLsizei size, const sdl::TextureView& textureView, std::invocable<std::span<Vertex>> auto&& writeVertexes);
+
 		void upload(sdl::Shader& shader);
 
+		// Draw each batch with the minimal shader permutation, e.g. untextured batches skip the texture sample.
+		// The features of the color pipeline are added, see colorpipeline::getShaderFeatures().
+		void upload(sdl::ShaderPermutations& shaders);
+
+		// Extra features added to all permutations used by upload, e.g. ShaderFeatures::AlphaTest.
+		void setShaderFeatures(ShaderFeatures features) noexcept {
+			shaderFeatures_ = features;
+		}
+
+		ShaderFeatures getShaderFeatures() const noexcept {
+			return shaderFeatures_;
+		}
+
 		void clear();
 
 	protected:
@@ -134,6 +153,7 @@ namespace sdl {
 		std::vector<BatchData> batches_;
 		sdl::VertexArrayObject vao_;
 		int currentMatrixIndex_ = 0;
+		ShaderFeatures shaderFeatures_ = ShaderFeatures::None;
 		bool initiated_ = false;
 		bool dirty_ = true;
 	};
@@ -148,6 +168,17 @@ namespace sdl {
 		add(batch_.getBatchView(gl::GL_LINES));
 	}
 
+	void Graphic::addQuads(gl::GLsizei size, const sdl::TextureView& textureView, std::invocable<std::span<Vertex>> auto&& writeVertexes) {
+		if (size <= 0) {
+			return;
+		}
+		batch_.startBatchView();
+		batch_.startAdding();
+		writeVertexes(batch_.growVertexes(size * 4));
+		batch_.insertQuadIndexes(size);
+		add(batch_.getBatchView(gl::GL_TRIANGLES), textureView);
+	}
+
 	inline void Graphic::addPixelLine(std::initializer_list<glm::vec2> points, Color color) {
 		addPixelLine(points.begin(), points.end(), color);
 	}
@@ -0,0 +1,23 @@
+#ifndef CPPSDL2_SDL_HASH_H
+#define CPPSDL2_SDL_HASH_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace sdl {
+
+	constexpr std::uint64_t FnvOffsetBasis = 14695981039346656037ull;
+	constexpr std::uint64_t FnvPrime = 1099511628211ull;
+
+	// 64-bit FNV-1a hash, continue hashing by passing the previous hash.
+	constexpr std::uint64_t fnv1a(std::string_view str, std::uint64_t hash = FnvOffsetBasis) noexcept {
+		for (char c : str) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= FnvPrime;
+		}
+		return hash;
+	}
+
+}
+
+#endif
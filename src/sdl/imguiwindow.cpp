@@ -1,4 +1,7 @@
 #include "imguiwindow.h"
+#include "glstate.h"
+#include "profiler.h"
+#include "renderstats.h"
 
 #include <spdlog/spdlog.h>
 #include <imgui_impl_sdl2.h>
@@ -74,11 +77,28 @@ namespace sdl {
 		if (showColorWindow_) {
 			showColorWindow(showColorWindow_);
 		}
+		if (showProfilerWindow_) {
+			profiler::showWindow(showProfilerWindow_);
+		}
+		if (showRenderStatsWindow_) {
+			renderstats::showWindow(showRenderStatsWindow_);
+		}
+		if (showLatencyWindow_) {
+			getLatencyMonitor().showWindow(showLatencyWindow_);
+		}
 
 		ImGui::Render();
 		const auto& io = ImGui::GetIO();
 		gl::glViewport(0, 0, static_cast<int>(io.DisplaySize.x), static_cast<int>(io.DisplaySize.y));
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		{
+			SDL_PROFILE_SCOPE("ImGui render");
+			SDL_PROFILE_GPU_SCOPE("ImGui render");
+			// ImGui colors are sRGB and blended in gamma space, i.e. not encoded again.
+			glstate::setEnabled(gl::GL_FRAMEBUFFER_SRGB, false);
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			// ImGui changes the OpenGL state behind the cache.
+			glstate::invalidate();
+		}
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
 			auto backupCurrentWindow = SDL_GL_GetCurrentWindow();
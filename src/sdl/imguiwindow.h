@@ -21,11 +21,25 @@ namespace sdl {
 		bool isShowColorWindow() const;
 		void setShowColorWindow(bool show);
 
+		bool isShowProfilerWindow() const;
+		void setShowProfilerWindow(bool show);
+
+		bool isShowRenderStatsWindow() const;
+		void setShowRenderStatsWindow(bool show);
+
+		bool isShowLatencyWindow() const;
+		void setShowLatencyWindow(bool show);
+
 	protected:
 		void initPreLoop() override;
 
 		void eventUpdate(const SDL_Event& windowEvent) override;
 
+		// ImGui renders in update(), i.e. on the main thread.
+		bool isRenderThreadSupported() const override {
+			return false;
+		}
+
 	private:
 		void update(const DeltaTime& deltaTime) final;
 		
@@ -36,6 +50,9 @@ namespace sdl {
 		
 		bool showDemoWindow_ = false;
 		bool showColorWindow_ = false;
+		bool showProfilerWindow_ = false;
+		bool showRenderStatsWindow_ = false;
+		bool showLatencyWindow_ = false;
 	};
 
 	inline bool ImGuiWindow::isShowDemoWindow() const {
@@ -54,6 +71,30 @@ namespace sdl {
 		showColorWindow_ = show;
 	}
 
+	inline bool ImGuiWindow::isShowProfilerWindow() const {
+		return showProfilerWindow_;
+	}
+
+	inline void ImGuiWindow::setShowProfilerWindow(bool show) {
+		showProfilerWindow_ = show;
+	}
+
+	inline bool ImGuiWindow::isShowRenderStatsWindow() const {
+		return showRenderStatsWindow_;
+	}
+
+	inline void ImGuiWindow::setShowRenderStatsWindow(bool show) {
+		showRenderStatsWindow_ = show;
+	}
+
+	inline bool ImGuiWindow::isShowLatencyWindow() const {
+		return showLatencyWindow_;
+	}
+
+	inline void ImGuiWindow::setShowLatencyWindow(bool show) {
+		showLatencyWindow_ = show;
+	}
+
 }
 
 #endif
@@ -7,9 +7,12 @@
 
 namespace sdl {
 
-	InitSdl::InitSdl(Uint32 flags)
+	InitSdl::InitSdl(Uint32 flags, const char* videoDriver)
 		: flags_{flags} {
 
+		if (videoDriver != nullptr) {
+			SDL_SetHint(SDL_HINT_VIDEODRIVER, videoDriver);
+		}
 		if (flags & SDL_INIT_VIDEO) {
 			initSdl();
 		}
@@ -7,7 +7,9 @@ namespace sdl {
 
 	class InitSdl {
 	public:
-		explicit InitSdl(Uint32 flags = SDL_INIT_VIDEO);
+		// The video driver is chosen by SDL if null, use e.g. "offscreen" for headless windows
+		// on a machine without display.
+		explicit InitSdl(Uint32 flags = SDL_INIT_VIDEO, const char* videoDriver = nullptr);
 		~InitSdl();
 		
 		InitSdl(const InitSdl&) = delete;
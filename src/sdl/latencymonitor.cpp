@@ -0,0 +1,119 @@
+#include "latencymonitor.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+
+namespace sdl {
+
+	namespace {
+
+		double toMilliseconds(LatencyMonitor::TimePoint::duration duration) {
+			return std::chrono::duration<double, std::milli>(duration).count();
+		}
+
+		void percentileRow(const char* name, const Statistics& statistics) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(name);
+			for (double value : {statistics.getPercentile(50), statistics.getPercentile(90), statistics.getPercentile(99), statistics.getMax()}) {
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", value);
+			}
+		}
+
+	}
+
+	void LatencyMonitor::addInput(TimePoint time) noexcept {
+		if (!enabled_) {
+			return;
+		}
+		auto rep = time.time_since_epoch().count();
+		auto pending = pendingInput_.load(std::memory_order_relaxed);
+		while ((pending == NoInput || rep < pending) && !pendingInput_.compare_exchange_weak(pending, rep)) {
+		}
+	}
+
+	std::optional<LatencyMonitor::TimePoint> LatencyMonitor::takeInput() noexcept {
+		if (auto rep = pendingInput_.exchange(NoInput); rep != NoInput) {
+			return TimePoint{TimePoint::duration{rep}};
+		}
+		return std::nullopt;
+	}
+
+	void LatencyMonitor::beginRender() noexcept {
+		beginRender(takeInput());
+	}
+
+	void LatencyMonitor::beginRender(std::optional<TimePoint> input) noexcept {
+		hasRenderInput_ = input.has_value();
+		if (hasRenderInput_) {
+			renderInput_ = *input;
+		}
+	}
+
+	void LatencyMonitor::endRender() {
+		if (!enabled_) {
+			return;
+		}
+		if (hasRenderInput_) {
+			hasRenderInput_ = false;
+			swapLatency_.add(toMilliseconds(std::chrono::high_resolution_clock::now() - renderInput_));
+
+			if (fences_.size() < MaxPendingFences) {
+				fences_.push_back({gl::glFenceSync(gl::GL_SYNC_GPU_COMMANDS_COMPLETE, gl::UnusedMask{}), renderInput_});
+			}
+		}
+		pollFences();
+	}
+
+	void LatencyMonitor::pollFences() {
+		auto now = std::chrono::high_resolution_clock::now();
+		auto it = std::remove_if(fences_.begin(), fences_.end(), [&](const Fence& fence) {
+			auto status = gl::glClientWaitSync(fence.sync, gl::SyncObjectMask{}, 0);
+			if (status != gl::GL_ALREADY_SIGNALED && status != gl::GL_CONDITION_SATISFIED) {
+				return false;
+			}
+			gpuLatency_.add(toMilliseconds(now - fence.input));
+			gl::glDeleteSync(fence.sync);
+			return true;
+		});
+		fences_.erase(it, fences_.end());
+	}
+
+	void LatencyMonitor::clear() {
+		for (auto& fence : fences_) {
+			gl::glDeleteSync(fence.sync);
+		}
+		fences_.clear();
+		swapLatency_.clear();
+		gpuLatency_.clear();
+	}
+
+	void LatencyMonitor::showWindow(bool& open) {
+		ImGui::Window("Input Latency", &open, ImGuiWindowFlags_AlwaysAutoResize, [&]() {
+			bool enabled = isEnabled();
+			if (ImGui::Checkbox("Measure", &enabled)) {
+				setEnabled(enabled);
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Clear")) {
+				clear();
+			}
+			ImGui::Text("Frames with input: %d", static_cast<int>(swapLatency_.getTotalCount()));
+
+			if (ImGui::BeginTable("Latency", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+				ImGui::TableSetupColumn("(ms)");
+				ImGui::TableSetupColumn("p50");
+				ImGui::TableSetupColumn("p90");
+				ImGui::TableSetupColumn("p99");
+				ImGui::TableSetupColumn("Max");
+				ImGui::TableHeadersRow();
+				percentileRow("Swap", swapLatency_);
+				percentileRow("Gpu", gpuLatency_);
+				ImGui::EndTable();
+			}
+		});
+	}
+
+}
@@ -0,0 +1,97 @@
+#ifndef CPPSDL2_SDL_LATENCYMONITOR_H
+#define CPPSDL2_SDL_LATENCYMONITOR_H
+
+#include "opengl.h"
+#include "statistics.h"
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace sdl {
+
+	// Measures the latency from an input event to the swap of the frame reflecting it, and
+	// to the gpu finishing the frame, approximated by a fence sync. Used by the window loop.
+	class LatencyMonitor {
+	public:
+		using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+		LatencyMonitor() = default;
+
+		LatencyMonitor(const LatencyMonitor&) = delete;
+		LatencyMonitor& operator=(const LatencyMonitor&) = delete;
+
+		// Turn the measurement on or off, off by default.
+		void setEnabled(bool enabled) noexcept;
+
+		bool isEnabled() const noexcept;
+
+		// Called when input is polled, the oldest input not yet rendered is kept.
+		void addInput(TimePoint time) noexcept;
+
+		// Return the pending input and clear it, called when the frame reflecting it is published.
+		std::optional<TimePoint> takeInput() noexcept;
+
+		// Called on the OpenGL thread before the frame is rendered, takes the pending input.
+		void beginRender() noexcept;
+
+		// Called on the OpenGL thread before the frame is rendered, with the input taken
+		// by takeInput() when the frame was published, e.g. by another thread.
+		void beginRender(std::optional<TimePoint> input) noexcept;
+
+		// Called on the OpenGL thread directly after the swap.
+		void endRender();
+
+		// Latency in milliseconds from input to the swap returned.
+		const Statistics& getSwapLatency() const noexcept;
+
+		// Latency in milliseconds from input to the gpu finished the frame. Fences are polled
+		// each frame, i.e. the resolution is about one frame.
+		const Statistics& getGpuLatency() const noexcept;
+
+		// Clear the statistics and delete the pending fences, must be called on the OpenGL thread.
+		void clear();
+
+		// Show an ImGui window with the latency percentiles, must be called on the OpenGL thread.
+		void showWindow(bool& open);
+
+	private:
+		static constexpr TimePoint::rep NoInput = 0;
+		static constexpr std::size_t MaxPendingFences = 8;
+
+		struct Fence {
+			gl::GLsync sync;
+			TimePoint input;
+		};
+
+		void pollFences();
+
+		std::atomic<TimePoint::rep> pendingInput_{NoInput};
+		TimePoint renderInput_{};
+		bool hasRenderInput_ = false;
+		std::vector<Fence> fences_;
+		Statistics swapLatency_;
+		Statistics gpuLatency_;
+		std::atomic<bool> enabled_ = false;
+	};
+
+	inline void LatencyMonitor::setEnabled(bool enabled) noexcept {
+		enabled_ = enabled;
+	}
+
+	inline bool LatencyMonitor::isEnabled() const noexcept {
+		return enabled_;
+	}
+
+	inline const Statistics& LatencyMonitor::getSwapLatency() const noexcept {
+		return swapLatency_;
+	}
+
+	inline const Statistics& LatencyMonitor::getGpuLatency() const noexcept {
+		return gpuLatency_;
+	}
+
+}
+
+#endif
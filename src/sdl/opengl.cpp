@@ -1,3 +1,27 @@
 #include "opengl.h"
 
 #include <spdlog/spdlog.h>
+
+namespace sdl {
+
+	bool isExtensionSupported(std::string_view extension) {
+		gl::GLint size = 0;
+		gl::glGetIntegerv(gl::GL_NUM_EXTENSIONS, &size);
+		for (gl::GLint i = 0; i < size; ++i) {
+			auto name = reinterpret_cast<const char*>(gl::glGetStringi(gl::GL_EXTENSIONS, static_cast<gl::GLuint>(i)));
+			if (name != nullptr && extension == name) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool isVersionSupported(int major, int minor) {
+		gl::GLint currentMajor = 0;
+		gl::GLint currentMinor = 0;
+		gl::glGetIntegerv(gl::GL_MAJOR_VERSION, &currentMajor);
+		gl::glGetIntegerv(gl::GL_MINOR_VERSION, &currentMinor);
+		return currentMajor > major || (currentMajor == major && currentMinor >= minor);
+	}
+
+}
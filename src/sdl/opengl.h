@@ -3,10 +3,25 @@
 
 #include <glbinding/gl/gl.h>
 
+#include <string_view>
 #include <tuple>
 
 namespace sdl {
+
+	// Return true if the current OpenGL context supports the extension, e.g. "GL_KHR_debug".
+	bool isExtensionSupported(std::string_view extension);
+
+	// Return true if the current OpenGL context version is at least major.minor.
+	bool isVersionSupported(int major, int minor);
 		
+	namespace glstate {
+
+		// Declared in glstate.h.
+		void setEnabled(gl::GLenum cap, bool enabled);
+
+	}
+
+	// Enable the capabilities through the glstate cache, disabled when destructed.
 	template <typename... Caps>
 	requires std::conjunction_v<std::is_same<gl::GLenum, Caps>...>
 	class GlEnableScoped {
@@ -14,13 +29,13 @@ namespace sdl {
 		explicit GlEnableScoped(Caps... caps)
 			: caps_{caps...} {
 			std::apply([](auto&&... caps) {
-				((glEnable(caps)), ...);
+				((glstate::setEnabled(caps, true)), ...);
 			}, caps_);
 		}
 
 		~GlEnableScoped() {
 			std::apply([](auto&&... caps) {
-				((gl::glDisable(caps)), ...);
+				((glstate::setEnabled(caps, false)), ...);
 			}, caps_);
 		}
 
@@ -0,0 +1,30 @@
+#ifndef CPPSDL2_SDL_PARALLEL_H
+#define CPPSDL2_SDL_PARALLEL_H
+
+#include <concepts>
+#include <thread>
+#include <vector>
+
+namespace sdl {
+
+	// Split [0, size) into workers ranges, the calling thread takes the last one.
+	void parallelFor(int size, int workers, std::invocable<int, int> auto&& function) {
+		if (workers <= 1) {
+			function(0, size);
+			return;
+		}
+
+		std::vector<std::jthread> threads;
+		threads.reserve(workers - 1);
+		int chunk = (size + workers - 1) / workers;
+		for (int begin = 0; begin < size - chunk; begin += chunk) {
+			threads.emplace_back([&function, begin, end = begin + chunk]() {
+				function(begin, end);
+			});
+		}
+		function(static_cast<int>(threads.size()) * chunk, size);
+	}
+
+}
+
+#endif
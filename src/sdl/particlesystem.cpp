@@ -0,0 +1,191 @@
+#include "particlesystem.h"
+#include "parallel.h"
+#include "simd.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace sdl {
+
+	namespace {
+
+		template <typename Type>
+		void swapRemove(std::vector<Type>& vector, int index) {
+			vector[index] = vector.back();
+			vector.pop_back();
+		}
+
+	}
+
+	ParticleSystem::ParticleSystem(int maxSize)
+		: maxSize_{std::max(maxSize, 0)} {
+
+		posX_.reserve(maxSize_);
+		posY_.reserve(maxSize_);
+		velocityX_.reserve(maxSize_);
+		velocityY_.reserve(maxSize_);
+		lifeTime_.reserve(maxSize_);
+		invTotalLifeTime_.reserve(maxSize_);
+		size_.reserve(maxSize_);
+		color_.reserve(maxSize_);
+	}
+
+	bool ParticleSystem::emit(const Particle& particle) {
+		if (getSize() >= maxSize_ || particle.lifeTime <= 0.f) {
+			return false;
+		}
+		posX_.push_back(particle.pos.x);
+		posY_.push_back(particle.pos.y);
+		velocityX_.push_back(particle.velocity.x);
+		velocityY_.push_back(particle.velocity.y);
+		lifeTime_.push_back(particle.lifeTime);
+		invTotalLifeTime_.push_back(1.f / particle.lifeTime);
+		size_.push_back(particle.size);
+		color_.push_back(particle.color);
+		return true;
+	}
+
+	void ParticleSystem::setThreads(int threads, int minParticlesPerThread) {
+		if (threads < 1) {
+			spdlog::warn("[sdl::ParticleSystem] Threads must be at least one, {} is ignored", threads);
+			return;
+		}
+		threads_ = threads;
+		minParticlesPerThread_ = std::max(minParticlesPerThread, 1);
+	}
+
+	int ParticleSystem::getWorkers() const noexcept {
+		return std::clamp(getSize() / minParticlesPerThread_, 1, threads_);
+	}
+
+	void ParticleSystem::update(const DeltaTime& deltaTime) {
+		if (isEmpty()) {
+			return;
+		}
+		float seconds = std::chrono::duration<float>(deltaTime).count();
+		parallelFor(getSize(), getWorkers(), [this, seconds](int begin, int end) {
+			updateRange(seconds, begin, end);
+		});
+		removeDead();
+	}
+
+	void ParticleSystem::updateRange(float deltaTime, int begin, int end) {
+		float accX = acceleration_.x * deltaTime;
+		float accY = acceleration_.y * deltaTime;
+		float* posX = posX_.data();
+		float* posY = posY_.data();
+		float* velocityX = velocityX_.data();
+		float* velocityY = velocityY_.data();
+		float* lifeTime = lifeTime_.data();
+
+		int i = begin;
+#if CPPSDL2_SSE2
+		const __m128 dt = _mm_set1_ps(deltaTime);
+		const __m128 ax = _mm_set1_ps(accX);
+		const __m128 ay = _mm_set1_ps(accY);
+		for (; i + 4 <= end; i += 4) {
+			__m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + i), ax);
+			__m128 vy = _mm_add_ps(_mm_loadu_ps(velocityY + i), ay);
+			_mm_storeu_ps(velocityX + i, vx);
+			_mm_storeu_ps(velocityY + i, vy);
+			_mm_storeu_ps(posX + i, _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(vx, dt)));
+			_mm_storeu_ps(posY + i, _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(vy, dt)));
+			_mm_storeu_ps(lifeTime + i, _mm_sub_ps(_mm_loadu_ps(lifeTime + i), dt));
+		}
+#endif
+		for (; i < end; ++i) {
+			velocityX[i] += accX;
+			velocityY[i] += accY;
+			posX[i] += velocityX[i] * deltaTime;
+			posY[i] += velocityY[i] * deltaTime;
+			lifeTime[i] -= deltaTime;
+		}
+	}
+
+	void ParticleSystem::removeDead() {
+		// Iterate backwards, the swapped in particle is then already checked.
+		for (int i = getSize() - 1; i >= 0; --i) {
+			if (lifeTime_[i] <= 0.f) {
+				removeAt(i);
+			}
+		}
+	}
+
+	void ParticleSystem::removeAt(int index) {
+		swapRemove(posX_, index);
+		swapRemove(posY_, index);
+		swapRemove(velocityX_, index);
+		swapRemove(velocityY_, index);
+		swapRemove(lifeTime_, index);
+		swapRemove(invTotalLifeTime_, index);
+		swapRemove(size_, index);
+		swapRemove(color_, index);
+	}
+
+	void ParticleSystem::clear() {
+		posX_.clear();
+		posY_.clear();
+		velocityX_.clear();
+		velocityY_.clear();
+		lifeTime_.clear();
+		invTotalLifeTime_.clear();
+		size_.clear();
+		color_.clear();
+	}
+
+	void ParticleSystem::addToBatch(BatchIndexed<Vertex>& batch, const TextureView& textureView) const {
+		if (isEmpty()) {
+			return;
+		}
+		batch.startAdding();
+		auto vertexes = batch.growVertexes(getSize() * 4);
+		if (vertexes.empty()) {
+			return;
+		}
+		writeQuads(vertexes, textureView);
+		batch.insertQuadIndexes(getSize());
+	}
+
+	void ParticleSystem::draw(Graphic& graphic, const TextureView& textureView) const {
+		graphic.addQuads(getSize(), textureView, [&](std::span<Vertex> vertexes) {
+			writeQuads(vertexes, textureView);
+		});
+	}
+
+	void ParticleSystem::writeQuads(std::span<Vertex> vertexes, const TextureView& textureView) const {
+		parallelFor(getSize(), getWorkers(), [&](int begin, int end) {
+			writeQuads(vertexes, textureView, begin, end);
+		});
+	}
+
+	void ParticleSystem::writeQuads(std::span<Vertex> vertexes, const TextureView& textureView, int begin, int end) const {
+		const float x = textureView.getX();
+		const float y = textureView.getY();
+		const float w = textureView.getWidth();
+		const float h = textureView.getHeight();
+
+		for (int i = begin; i < end; ++i) {
+			float halfSize = 0.5f * size_[i];
+			float left = posX_[i] - halfSize;
+			float right = posX_[i] + halfSize;
+			float bottom = posY_[i] - halfSize;
+			float top = posY_[i] + halfSize;
+
+			Color color = color_[i];
+			if (fadeOut_) {
+				float alpha = std::clamp(lifeTime_[i] * invTotalLifeTime_[i], 0.f, 1.f);
+				color = Color::createU32(color.redByte(), color.greenByte(), color.blueByte(), static_cast<uint8_t>(color.alphaByte() * alpha));
+			}
+
+			// Same texture mapping as graphic::addRectangleImage.
+			auto quad = vertexes.subspan(static_cast<std::size_t>(i) * 4, 4);
+			quad[0] = {{left, bottom}, {x, y + h}, color};
+			quad[1] = {{right, bottom}, {x + w, y + h}, color};
+			quad[2] = {{right, top}, {x + w, y}, color};
+			quad[3] = {{left, top}, {x, y}, color};
+		}
+	}
+
+}
@@ -0,0 +1,128 @@
+#ifndef CPPSDL2_SDL_PARTICLESYSTEM_H
+#define CPPSDL2_SDL_PARTICLESYSTEM_H
+
+#include "batch.h"
+#include "color.h"
+#include "graphic.h"
+#include "textureview.h"
+#include "vertex.h"
+#include "window.h"
+
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <vector>
+
+namespace sdl {
+
+	struct Particle {
+		glm::vec2 pos;
+		glm::vec2 velocity;
+		float lifeTime;
+		float size;
+		Color color = color::White;
+	};
+
+	// Particles stored as structure of arrays, in order for the update to be
+	// vectorized and the quads to be written in bulk to the batch.
+	class ParticleSystem {
+	public:
+		explicit ParticleSystem(int maxSize = 10'000);
+
+		// Return false if the particle system is full.
+		bool emit(const Particle& particle);
+
+		// Set the acceleration applied to every particle, e.g. gravity.
+		void setAcceleration(const glm::vec2& acceleration) noexcept;
+
+		const glm::vec2& getAcceleration() const noexcept;
+
+		// Particles fade out, i.e. the alpha goes linear to zero during the life time.
+		void setFadeOut(bool fadeOut) noexcept;
+
+		bool isFadeOut() const noexcept;
+
+		// Use up to threads worker threads for the update and the vertex writing,
+		// but only when the number of particles is at least minParticlesPerThread
+		// per thread. Default is one thread, i.e. no worker threads.
+		void setThreads(int threads, int minParticlesPerThread = 50'000);
+
+		int getThreads() const noexcept;
+
+		// Move all particles and remove the dead ones.
+		void update(const DeltaTime& deltaTime);
+
+		void clear();
+
+		int getSize() const noexcept;
+
+		int getMaxSize() const noexcept;
+
+		bool isEmpty() const noexcept;
+
+		// Add one quad per particle to the batch.
+		void addToBatch(BatchIndexed<Vertex>& batch, const TextureView& textureView = {}) const;
+
+		// Add one quad per particle to the graphic.
+		void draw(Graphic& graphic, const TextureView& textureView = {}) const;
+
+	private:
+		void writeQuads(std::span<Vertex> vertexes, const TextureView& textureView) const;
+		void writeQuads(std::span<Vertex> vertexes, const TextureView& textureView, int begin, int end) const;
+		void updateRange(float deltaTime, int begin, int end);
+		void removeDead();
+		void removeAt(int index);
+
+		int getWorkers() const noexcept;
+
+		std::vector<float> posX_;
+		std::vector<float> posY_;
+		std::vector<float> velocityX_;
+		std::vector<float> velocityY_;
+		std::vector<float> lifeTime_;
+		std::vector<float> invTotalLifeTime_;
+		std::vector<float> size_;
+		std::vector<Color> color_;
+
+		glm::vec2 acceleration_{0.f, 0.f};
+		int maxSize_ = 0;
+		int threads_ = 1;
+		int minParticlesPerThread_ = 50'000;
+		bool fadeOut_ = false;
+	};
+
+	inline void ParticleSystem::setAcceleration(const glm::vec2& acceleration) noexcept {
+		acceleration_ = acceleration;
+	}
+
+	inline const glm::vec2& ParticleSystem::getAcceleration() const noexcept {
+		return acceleration_;
+	}
+
+	inline void ParticleSystem::setFadeOut(bool fadeOut) noexcept {
+		fadeOut_ = fadeOut;
+	}
+
+	inline bool ParticleSystem::isFadeOut() const noexcept {
+		return fadeOut_;
+	}
+
+	inline int ParticleSystem::getThreads() const noexcept {
+		return threads_;
+	}
+
+	inline int ParticleSystem::getSize() const noexcept {
+		return static_cast<int>(posX_.size());
+	}
+
+	inline int ParticleSystem::getMaxSize() const noexcept {
+		return maxSize_;
+	}
+
+	inline bool ParticleSystem::isEmpty() const noexcept {
+		return posX_.empty();
+	}
+
+}
+
+#endif
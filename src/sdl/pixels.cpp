@@ -0,0 +1,218 @@
+#include "pixels.h"
+#include "parallel.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace sdl::pixels {
+
+	namespace {
+
+		// Smaller images are not worth the thread start.
+		constexpr std::int64_t MinBytesPerThread = 512 * 1024;
+
+		std::atomic<int> maxThreads_{static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))};
+
+		void forEachBand(int height, std::int64_t bytes, std::invocable<int, int> auto&& function) {
+			const auto workers = std::clamp<std::int64_t>(bytes / MinBytesPerThread, 1, std::max(1, std::min(maxThreads_.load(), height)));
+			parallelFor(height, static_cast<int>(workers), function);
+		}
+
+		const std::uint8_t* row(const void* pixels, int pitch, int y) noexcept {
+			return static_cast<const std::uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * pitch;
+		}
+
+		std::uint8_t* row(void* pixels, int pitch, int y) noexcept {
+			return static_cast<std::uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * pitch;
+		}
+
+		void rgbToRgbaRow(const std::uint8_t* src, std::uint8_t* dst, int width) noexcept {
+			int i = 0;
+#if CPPSDL2_AVX2
+			const auto shuffle = _mm256_setr_epi8(
+				0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+				0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			const auto alpha = _mm256_set1_epi32(static_cast<int>(0xff'00'00'00u));
+			// Reads 4 bytes beyond the 8 pixels, i.e. stops two pixels before the end.
+			for (; i + 10 <= width; i += 8) {
+				const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+				const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i + 12));
+				const auto rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffle), alpha));
+			}
+#endif
+			for (; i < width; ++i) {
+				dst[4 * i] = src[3 * i];
+				dst[4 * i + 1] = src[3 * i + 1];
+				dst[4 * i + 2] = src[3 * i + 2];
+				dst[4 * i + 3] = 255;
+			}
+		}
+
+		void rgbaToRgbRow(const std::uint8_t* src, std::uint8_t* dst, int width) noexcept {
+			int i = 0;
+#if CPPSDL2_AVX2
+			const auto shuffle = _mm256_setr_epi8(
+				0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+				0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+			// Writes 4 bytes beyond the 8 pixels, overwritten by the next iteration.
+			for (; i + 10 <= width; i += 8) {
+				const auto rgb = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i)), shuffle);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i), _mm256_castsi256_si128(rgb));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i + 12), _mm256_extracti128_si256(rgb, 1));
+			}
+#endif
+			for (; i < width; ++i) {
+				dst[3 * i] = src[4 * i];
+				dst[3 * i + 1] = src[4 * i + 1];
+				dst[3 * i + 2] = src[4 * i + 2];
+			}
+		}
+
+		void bgraToRgbaRow(const std::uint8_t* src, std::uint8_t* dst, int width) noexcept {
+			int i = 0;
+#if CPPSDL2_AVX2
+			const auto shuffle = _mm256_setr_epi8(
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+			for (; i + 8 <= width; i += 8) {
+				const auto bgra = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_shuffle_epi8(bgra, shuffle));
+			}
+#endif
+#if CPPSDL2_SSE2
+			// No byte shuffle in SSE2, swaps the red and blue bytes with shifts.
+			const auto greenAlpha = _mm_set1_epi32(static_cast<int>(0xff'00'ff'00u));
+			const auto redBlue = _mm_set1_epi32(0x00'ff'00'ff);
+			for (; i + 4 <= width; i += 4) {
+				const auto bgra = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+				const auto rb = _mm_and_si128(bgra, redBlue);
+				const auto swapped = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_or_si128(_mm_and_si128(bgra, greenAlpha), swapped));
+			}
+#endif
+			for (; i < width; ++i) {
+				const auto blue = src[4 * i];
+				dst[4 * i + 1] = src[4 * i + 1];
+				dst[4 * i + 3] = src[4 * i + 3];
+				dst[4 * i] = src[4 * i + 2];
+				dst[4 * i + 2] = blue;
+			}
+		}
+
+		void alphaToRgbaRow(const std::uint8_t* src, std::uint8_t* dst, int width, Color color) noexcept {
+			int i = 0;
+#if CPPSDL2_SSE2
+			const auto zero = _mm_setzero_si128();
+			const auto rgb = _mm_set1_epi32(static_cast<int>(color.redByte() | (color.greenByte() << 8) | (color.blueByte() << 16)));
+			// Moves each alpha byte to the highest byte of a 32 bit lane.
+			for (; i + 16 <= width; i += 16) {
+				const auto alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				const auto lo = _mm_unpacklo_epi8(zero, alpha);
+				const auto hi = _mm_unpackhi_epi8(zero, alpha);
+				auto out = reinterpret_cast<__m128i*>(dst + 4 * i);
+				_mm_storeu_si128(out, _mm_or_si128(_mm_unpacklo_epi16(zero, lo), rgb));
+				_mm_storeu_si128(out + 1, _mm_or_si128(_mm_unpackhi_epi16(zero, lo), rgb));
+				_mm_storeu_si128(out + 2, _mm_or_si128(_mm_unpacklo_epi16(zero, hi), rgb));
+				_mm_storeu_si128(out + 3, _mm_or_si128(_mm_unpackhi_epi16(zero, hi), rgb));
+			}
+#endif
+			for (; i < width; ++i) {
+				dst[4 * i] = color.redByte();
+				dst[4 * i + 1] = color.greenByte();
+				dst[4 * i + 2] = color.blueByte();
+				dst[4 * i + 3] = src[i];
+			}
+		}
+
+		void convert(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height, int dstBytesPerPixel, auto&& convertRow) {
+			if (width <= 0 || height <= 0) {
+				return;
+			}
+			forEachBand(height, static_cast<std::int64_t>(width) * height * dstBytesPerPixel, [&](int begin, int end) {
+				for (int y = begin; y < end; ++y) {
+					convertRow(row(src, srcPitch, y), row(dst, dstPitch, y), width);
+				}
+			});
+		}
+
+	}
+
+	void setMaxThreads(int threads) {
+		maxThreads_ = std::max(threads, 1);
+	}
+
+	void flipVertical(void* pixels, int pitch, int rowBytes, int height) {
+		if (height < 2 || rowBytes <= 0) {
+			return;
+		}
+		forEachBand(height / 2, static_cast<std::int64_t>(rowBytes) * height, [&](int begin, int end) {
+			std::vector<std::uint8_t> temp(rowBytes);
+			for (int y = begin; y < end; ++y) {
+				auto top = row(pixels, pitch, y);
+				auto bottom = row(pixels, pitch, height - 1 - y);
+				std::memcpy(temp.data(), top, rowBytes);
+				std::memcpy(top, bottom, rowBytes);
+				std::memcpy(bottom, temp.data(), rowBytes);
+			}
+		});
+	}
+
+	void copy(const void* src, int srcPitch, void* dst, int dstPitch, int rowBytes, int height) {
+		if (height <= 0 || rowBytes <= 0) {
+			return;
+		}
+		forEachBand(height, static_cast<std::int64_t>(rowBytes) * height, [&](int begin, int end) {
+			if (srcPitch == rowBytes && dstPitch == rowBytes) {
+				std::memcpy(row(dst, dstPitch, begin), row(src, srcPitch, begin), static_cast<std::size_t>(end - begin) * rowBytes);
+				return;
+			}
+			for (int y = begin; y < end; ++y) {
+				std::memcpy(row(dst, dstPitch, y), row(src, srcPitch, y), rowBytes);
+			}
+		});
+	}
+
+	void extrude(void* pixels, int pitch, int bytesPerPixel, int width, int height, int border) {
+		if (border <= 0 || width <= 2 * border || height <= 2 * border) {
+			return;
+		}
+		const int rowBytes = width * bytesPerPixel;
+		for (int y = border; y < height - border; ++y) {
+			auto line = row(pixels, pitch, y);
+			const auto first = line + border * bytesPerPixel;
+			const auto last = line + (width - border - 1) * bytesPerPixel;
+			for (int x = 0; x < border; ++x) {
+				std::memcpy(line + x * bytesPerPixel, first, bytesPerPixel);
+				std::memcpy(last + (x + 1) * bytesPerPixel, last, bytesPerPixel);
+			}
+		}
+		for (int y = 0; y < border; ++y) {
+			std::memcpy(row(pixels, pitch, y), row(pixels, pitch, border), rowBytes);
+			std::memcpy(row(pixels, pitch, height - 1 - y), row(pixels, pitch, height - border - 1), rowBytes);
+		}
+	}
+
+	void rgbToRgba(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height) {
+		convert(src, srcPitch, dst, dstPitch, width, height, 4, rgbToRgbaRow);
+	}
+
+	void rgbaToRgb(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height) {
+		convert(src, srcPitch, dst, dstPitch, width, height, 3, rgbaToRgbRow);
+	}
+
+	void bgraToRgba(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height) {
+		convert(src, srcPitch, dst, dstPitch, width, height, 4, bgraToRgbaRow);
+	}
+
+	void alphaToRgba(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height, Color color) {
+		convert(src, srcPitch, dst, dstPitch, width, height, 4, [color](const std::uint8_t* srcRow, std::uint8_t* dstRow, int width) {
+			alphaToRgbaRow(srcRow, dstRow, width, color);
+		});
+	}
+
+}
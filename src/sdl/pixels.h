@@ -0,0 +1,38 @@
+#ifndef CPPSDL2_SDL_PIXELS_H
+#define CPPSDL2_SDL_PIXELS_H
+
+#include "color.h"
+
+#include <cstdint>
+
+// Kernels working on rows of 8 bit per channel pixels, with the pitch in bytes between rows.
+// Large images are split into bands of rows processed by several threads.
+namespace sdl::pixels {
+
+	// Set the max number of threads used for large images, default is the number of cores.
+	void setMaxThreads(int threads);
+
+	// Swap the rows, i.e. the first row becomes the last.
+	void flipVertical(void* pixels, int pitch, int rowBytes, int height);
+
+	void copy(const void* src, int srcPitch, void* dst, int dstPitch, int rowBytes, int height);
+
+	// Fill the border around the inner image by repeating its edge pixels, e.g. to avoid
+	// bleeding between atlas images when filtered or mipmapped. Width and height include the border.
+	void extrude(void* pixels, int pitch, int bytesPerPixel, int width, int height, int border);
+
+	// RGB24 to RGBA32 with opaque alpha.
+	void rgbToRgba(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height);
+
+	// RGBA32 to RGB24, the alpha is dropped.
+	void rgbaToRgb(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height);
+
+	// Swap the red and blue channels, i.e. also RGBA32 to BGRA32. Src and dst may be the same.
+	void bgraToRgba(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height);
+
+	// Expand 8 bit alpha, e.g. a glyph, into RGBA32 with the rgb of the color.
+	void alphaToRgba(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height, Color color = color::White);
+
+}
+
+#endif
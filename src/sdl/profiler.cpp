@@ -0,0 +1,277 @@
+#include "profiler.h"
+
+#include <imgui.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace sdl::profiler {
+
+	namespace {
+
+		constexpr std::size_t RingSize = 1 << 14;
+		constexpr std::size_t MaxHistory = 1 << 18;
+
+		using ProfilerClock = std::chrono::steady_clock;
+
+		const ProfilerClock::time_point startTime = ProfilerClock::now();
+
+		struct ThreadRing {
+			std::array<ProfileEvent, RingSize> events{};
+			std::atomic<std::uint64_t> written{0};
+			std::uint64_t read = 0;
+			std::uint32_t thread = 0;
+		};
+
+		struct GpuQuery {
+			gl::GLuint query;
+			const char* name;
+			std::int64_t start;
+		};
+
+		std::mutex ringsMutex;
+		std::vector<std::shared_ptr<ThreadRing>> rings;
+
+		std::vector<gl::GLuint> freeQueries;
+		std::vector<GpuQuery> pendingQueries;
+		bool gpuQueryActive = false;
+
+		std::vector<ProfileEvent> history;
+		std::vector<ProfileEvent> lastFrame;
+		std::int64_t frameStart = 0;
+
+		ThreadRing& threadRing() {
+			thread_local std::shared_ptr<ThreadRing> ring = []() {
+				auto ring = std::make_shared<ThreadRing>();
+				std::scoped_lock lock{ringsMutex};
+				ring->thread = static_cast<std::uint32_t>(rings.size());
+				rings.push_back(ring);
+				return ring;
+			}();
+			return *ring;
+		}
+
+		void collectGpuQueries() {
+			auto it = std::remove_if(pendingQueries.begin(), pendingQueries.end(), [](const GpuQuery& gpuQuery) {
+				gl::GLint available = 0;
+				gl::glGetQueryObjectiv(gpuQuery.query, gl::GL_QUERY_RESULT_AVAILABLE, &available);
+				if (available == 0) {
+					return false;
+				}
+				gl::GLuint64 elapsed = 0;
+				gl::glGetQueryObjectui64v(gpuQuery.query, gl::GL_QUERY_RESULT, &elapsed);
+				history.push_back({gpuQuery.name, gpuQuery.start, static_cast<std::int64_t>(elapsed), GpuThread, 0, true});
+				freeQueries.push_back(gpuQuery.query);
+				return true;
+			});
+			pendingQueries.erase(it, pendingQueries.end());
+		}
+
+		void writeJsonString(std::ofstream& out, const char* str) {
+			out << '"';
+			for (; *str != '\0'; ++str) {
+				if (*str == '"' || *str == '\\') {
+					out << '\\';
+				}
+				out << *str;
+			}
+			out << '"';
+		}
+
+	}
+
+	std::int64_t now() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(ProfilerClock::now() - startTime).count();
+	}
+
+	std::uint32_t& threadDepth() noexcept {
+		thread_local std::uint32_t depth = 0;
+		return depth;
+	}
+
+	void record(const char* name, std::int64_t start, std::int64_t end, std::uint32_t depth) noexcept {
+		auto& ring = threadRing();
+		auto written = ring.written.load(std::memory_order_relaxed);
+		ring.events[written % RingSize] = {name, start, end - start, ring.thread, depth, false};
+		ring.written.store(written + 1, std::memory_order_release);
+	}
+
+	void beginGpu(const char* name) {
+		if (gpuQueryActive) {
+			spdlog::warn("[sdl::profiler] Gpu scope {} ignored, gpu scopes can't be nested", name);
+			return;
+		}
+		if (freeQueries.empty()) {
+			gl::GLuint query = 0;
+			gl::glGenQueries(1, &query);
+			freeQueries.push_back(query);
+		}
+		auto query = freeQueries.back();
+		freeQueries.pop_back();
+		pendingQueries.push_back({query, name, now()});
+		gl::glBeginQuery(gl::GL_TIME_ELAPSED, query);
+		gpuQueryActive = true;
+	}
+
+	void endGpu() {
+		if (gpuQueryActive) {
+			gl::glEndQuery(gl::GL_TIME_ELAPSED);
+			gpuQueryActive = false;
+		}
+	}
+
+	void newFrame() {
+		auto frameEnd = now();
+		auto historySize = history.size();
+		{
+			std::scoped_lock lock{ringsMutex};
+			for (auto& ring : rings) {
+				auto written = ring->written.load(std::memory_order_acquire);
+				if (written - ring->read > RingSize) {
+					ring->read = written - RingSize;
+				}
+				for (; ring->read < written; ++ring->read) {
+					history.push_back(ring->events[ring->read % RingSize]);
+				}
+			}
+		}
+		collectGpuQueries();
+
+		lastFrame.clear();
+		std::copy_if(history.begin() + historySize, history.end(), std::back_inserter(lastFrame), [&](const ProfileEvent& event) {
+			// Gpu results arrive a few frames late.
+			return event.gpu || (event.start >= frameStart && event.start < frameEnd);
+		});
+		frameStart = frameEnd;
+
+		if (history.size() > MaxHistory) {
+			history.erase(history.begin(), history.begin() + (history.size() - MaxHistory / 2));
+		}
+	}
+
+	const std::vector<ProfileEvent>& getLastFrame() {
+		return lastFrame;
+	}
+
+	const std::vector<ProfileEvent>& getHistory() {
+		return history;
+	}
+
+	void clearHistory() {
+		history.clear();
+	}
+
+	bool exportChromeTrace(const std::string& filename) {
+		std::ofstream out{filename};
+		if (!out) {
+			spdlog::error("[sdl::profiler] Failed to open {}", filename);
+			return false;
+		}
+
+		// Microseconds with nanosecond resolution, the default format switches to scientific notation.
+		out << std::fixed << std::setprecision(3);
+		out << "{\"traceEvents\":[\n";
+		bool first = true;
+		for (const auto& event : history) {
+			if (!first) {
+				out << ",\n";
+			}
+			first = false;
+			out << "{\"name\":";
+			writeJsonString(out, event.name);
+			out << ",\"cat\":\"" << (event.gpu ? "gpu" : "cpu") << "\",\"ph\":\"X\""
+				<< ",\"ts\":" << event.start / 1000.0
+				<< ",\"dur\":" << event.duration / 1000.0
+				<< ",\"pid\":0,\"tid\":" << event.thread << '}';
+		}
+		out << "\n]}\n";
+
+		spdlog::info("[sdl::profiler] Exported {} events to {}", history.size(), filename);
+		return static_cast<bool>(out);
+	}
+
+	void showWindow(bool& open) {
+		ImGui::Window("Profiler", &open, [&]() {
+			if (!isEnabled()) {
+				ImGui::TextUnformatted("Profiler markers not compiled, define CPPSDL2_PROFILER.");
+				return;
+			}
+			if (ImGui::Button("Export Chrome trace")) {
+				exportChromeTrace("trace.json");
+			}
+			ImGui::SameLine();
+			ImGui::Text("History: %d events", static_cast<int>(history.size()));
+
+			if (lastFrame.empty()) {
+				return;
+			}
+
+			// One lane per thread and depth, the gpu lane last.
+			std::map<std::pair<std::uint32_t, std::uint32_t>, int> lanes;
+			std::int64_t begin = lastFrame.front().start;
+			std::int64_t end = begin + 1;
+			for (const auto& event : lastFrame) {
+				lanes[{event.thread, event.depth}] = 0;
+				begin = std::min(begin, event.start);
+				end = std::max(end, event.start + event.duration);
+			}
+			int lane = 0;
+			for (auto& [key, index] : lanes) {
+				index = lane++;
+			}
+
+			ImGui::Text("Frame: %.3f ms", (end - begin) / 1e6);
+			const float laneHeight = ImGui::GetTextLineHeightWithSpacing();
+			const auto pos = ImGui::GetCursorScreenPos();
+			const float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+			const double scale = width / static_cast<double>(end - begin);
+			auto drawList = ImGui::GetWindowDrawList();
+
+			for (const auto& event : lastFrame) {
+				float x0 = pos.x + static_cast<float>((event.start - begin) * scale);
+				float x1 = std::max(x0 + 1.f, pos.x + static_cast<float>((event.start + event.duration - begin) * scale));
+				float y0 = pos.y + lanes[{event.thread, event.depth}] * laneHeight;
+				ImVec2 min{x0, y0};
+				ImVec2 max{x1, y0 + laneHeight - 1.f};
+				drawList->AddRectFilled(min, max, event.gpu ? IM_COL32(200, 90, 60, 255) : IM_COL32(60, 120, 200, 255));
+				drawList->PushClipRect(min, max, true);
+				drawList->AddText({x0 + 2.f, y0}, IM_COL32(255, 255, 255, 255), event.name);
+				drawList->PopClipRect();
+
+				auto mouse = ImGui::GetMousePos();
+				if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+					ImGui::SetTooltip("%s: %.3f ms", event.name, event.duration / 1e6);
+				}
+			}
+			ImGui::Dummy({width, lanes.size() * laneHeight});
+
+			std::map<std::string, std::int64_t> totals;
+			for (const auto& event : lastFrame) {
+				totals[event.name] += event.duration;
+			}
+			if (ImGui::BeginTable("Scopes", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+				ImGui::TableSetupColumn("Scope");
+				ImGui::TableSetupColumn("Time (ms)");
+				ImGui::TableHeadersRow();
+				for (const auto& [name, total] : totals) {
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(name.c_str());
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", total / 1e6);
+				}
+				ImGui::EndTable();
+			}
+		});
+	}
+
+}
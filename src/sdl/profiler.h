@@ -0,0 +1,125 @@
+#ifndef CPPSDL2_SDL_PROFILER_H
+#define CPPSDL2_SDL_PROFILER_H
+
+#include "opengl.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The markers are compiled in only when CPPSDL2_PROFILER is defined, e.g. by the
+// CMake option CppSdl2_Profiler, otherwise they expand to nothing.
+#ifdef CPPSDL2_PROFILER
+#define CPPSDL2_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CPPSDL2_PROFILE_CONCAT(a, b) CPPSDL2_PROFILE_CONCAT_IMPL(a, b)
+
+// Measure the cpu time of the current scope. Name must be a string literal.
+#define SDL_PROFILE_SCOPE(name) const ::sdl::ProfileScope CPPSDL2_PROFILE_CONCAT(sdlProfileScope, __LINE__){name}
+
+// Measure the gpu time of the current scope, must be called on the OpenGL thread and not be nested.
+#define SDL_PROFILE_GPU_SCOPE(name) const ::sdl::GpuProfileScope CPPSDL2_PROFILE_CONCAT(sdlGpuProfileScope, __LINE__){name}
+
+// Collect the events recorded since the last frame, called once each frame on the OpenGL thread.
+#define SDL_PROFILE_NEW_FRAME() ::sdl::profiler::newFrame()
+#else
+#define SDL_PROFILE_SCOPE(name) static_cast<void>(0)
+#define SDL_PROFILE_GPU_SCOPE(name) static_cast<void>(0)
+#define SDL_PROFILE_NEW_FRAME() static_cast<void>(0)
+#endif
+
+namespace sdl {
+
+	struct ProfileEvent {
+		const char* name;
+		// Nanoseconds since the profiler started.
+		std::int64_t start;
+		std::int64_t duration;
+		std::uint32_t thread;
+		std::uint32_t depth;
+		bool gpu;
+	};
+
+	namespace profiler {
+
+		// Thread id used for gpu events.
+		constexpr std::uint32_t GpuThread = 0xffffffff;
+
+		constexpr bool isEnabled() noexcept {
+#ifdef CPPSDL2_PROFILER
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		// Return nanoseconds since the profiler started.
+		std::int64_t now() noexcept;
+
+		// Record the event in the calling thread's ring buffer, older events are overwritten
+		// if not collected in time. Name must live as long as the profiler, e.g. a string literal.
+		void record(const char* name, std::int64_t start, std::int64_t end, std::uint32_t depth) noexcept;
+
+		std::uint32_t& threadDepth() noexcept;
+
+		void beginGpu(const char* name);
+
+		void endGpu();
+
+		// Collect the events from all threads and the finished gpu queries.
+		void newFrame();
+
+		// Return the events recorded during the last finished frame.
+		const std::vector<ProfileEvent>& getLastFrame();
+
+		// Return all collected events, at most a limited history.
+		const std::vector<ProfileEvent>& getHistory();
+
+		void clearHistory();
+
+		// Write the history as Chrome trace event JSON (chrome://tracing, Perfetto).
+		bool exportChromeTrace(const std::string& filename);
+
+		// Show an ImGui window with a timeline of the last frame.
+		void showWindow(bool& open);
+
+	}
+
+	class ProfileScope {
+	public:
+		explicit ProfileScope(const char* name) noexcept
+			: name_{name}
+			, start_{profiler::now()}
+			, depth_{profiler::threadDepth()++} {
+		}
+
+		~ProfileScope() {
+			--profiler::threadDepth();
+			profiler::record(name_, start_, profiler::now(), depth_);
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* name_;
+		std::int64_t start_;
+		std::uint32_t depth_;
+	};
+
+	class GpuProfileScope {
+	public:
+		explicit GpuProfileScope(const char* name) {
+			profiler::beginGpu(name);
+		}
+
+		~GpuProfileScope() {
+			profiler::endGpu();
+		}
+
+		GpuProfileScope(const GpuProfileScope&) = delete;
+		GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+	};
+
+}
+
+#endif
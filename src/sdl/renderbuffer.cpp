@@ -0,0 +1,69 @@
+#include "renderbuffer.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace sdl {
+
+	RenderBuffer::~RenderBuffer() {
+		if (renderBuffer_ != 0) {
+			gl::glDeleteRenderbuffers(1, &renderBuffer_);
+		}
+	}
+
+	RenderBuffer::RenderBuffer(RenderBuffer&& other) noexcept
+		: renderBuffer_{std::exchange(other.renderBuffer_, 0)}
+		, samples_{std::exchange(other.samples_, 0)} {
+
+	}
+
+	RenderBuffer& RenderBuffer::operator=(RenderBuffer&& other) noexcept {
+		if (renderBuffer_ != 0) {
+			gl::glDeleteRenderbuffers(1, &renderBuffer_);
+		}
+		renderBuffer_ = std::exchange(other.renderBuffer_, 0);
+		samples_ = std::exchange(other.samples_, 0);
+		return *this;
+	}
+
+	void RenderBuffer::bind() {
+		if (renderBuffer_ != 0) {
+			gl::glBindRenderbuffer(gl::GL_RENDERBUFFER, renderBuffer_);
+		} else {
+			spdlog::debug("[sdl::RenderBuffer] Must be generated first");
+		}
+	}
+
+	void RenderBuffer::generate() {
+		if (renderBuffer_ == 0) {
+			gl::glGenRenderbuffers(1, &renderBuffer_);
+		} else {
+			spdlog::warn("[sdl::RenderBuffer] tried to create, but render buffer already exists");
+		}
+	}
+
+	void RenderBuffer::storage(gl::GLenum internalFormat, int width, int height, int samples) {
+		if (!isValid()) {
+			spdlog::debug("[sdl::RenderBuffer] Failed to allocate storage, must be generated first");
+			return;
+		}
+		samples_ = std::clamp(samples, 0, getMaxSamples());
+		if (samples_ != samples) {
+			spdlog::warn("[sdl::RenderBuffer] {} samples not supported, uses {} samples", samples, samples_);
+		}
+		gl::glBindRenderbuffer(gl::GL_RENDERBUFFER, renderBuffer_);
+		gl::glRenderbufferStorageMultisample(gl::GL_RENDERBUFFER, samples_, internalFormat, width, height);
+	}
+
+	bool RenderBuffer::isValid() const noexcept {
+		return renderBuffer_ != 0;
+	}
+
+	int RenderBuffer::getMaxSamples() {
+		gl::GLint maxSamples = 0;
+		gl::glGetIntegerv(gl::GL_MAX_SAMPLES, &maxSamples);
+		return maxSamples;
+	}
+
+}
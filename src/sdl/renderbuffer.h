@@ -0,0 +1,60 @@
+#ifndef CPPSDL2_SDL_RENDERBUFFER_H
+#define CPPSDL2_SDL_RENDERBUFFER_H
+
+#include "opengl.h"
+
+namespace sdl {
+
+	class RenderBuffer {
+	public:
+		RenderBuffer() = default;
+		~RenderBuffer();
+
+		RenderBuffer(const RenderBuffer&) = delete;
+		RenderBuffer& operator=(const RenderBuffer&) = delete;
+
+		RenderBuffer(RenderBuffer&& other) noexcept;
+		RenderBuffer& operator=(RenderBuffer&& other) noexcept;
+
+		void bind();
+
+		void generate();
+
+		// Allocate the storage, multisampled if samples is larger than zero.
+		void storage(gl::GLenum internalFormat, int width, int height, int samples = 0);
+
+		bool isValid() const noexcept;
+
+		int getSamples() const noexcept;
+
+		// Return the maximum number of samples supported by the current context.
+		static int getMaxSamples();
+
+		friend bool operator==(const RenderBuffer& left, const RenderBuffer& right) noexcept;
+
+		friend bool operator!=(const RenderBuffer& left, const RenderBuffer& right) noexcept;
+
+		operator gl::GLuint() const noexcept {
+			return renderBuffer_;
+		}
+
+	private:
+		gl::GLuint renderBuffer_ = 0;
+		int samples_ = 0;
+	};
+
+	inline int RenderBuffer::getSamples() const noexcept {
+		return samples_;
+	}
+
+	inline bool operator==(const RenderBuffer& left, const RenderBuffer& right) noexcept {
+		return left.renderBuffer_ == right.renderBuffer_;
+	}
+
+	inline bool operator!=(const RenderBuffer& left, const RenderBuffer& right) noexcept {
+		return left.renderBuffer_ != right.renderBuffer_;
+	}
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "renderstats.h"
+
+#include <imgui.h>
+
+#include <atomic>
+
+namespace sdl::renderstats {
+
+	namespace {
+
+		RenderStats currentFrame;
+		RenderStats lastFrame;
+
+		// Added by Graphic, possibly on another thread, moved into the frame by newFrame().
+		std::atomic<int> batchViews{0};
+		std::atomic<int> mergedBatchViews{0};
+
+	}
+
+	RenderStats& current() noexcept {
+		return currentFrame;
+	}
+
+	const RenderStats& getLastFrame() noexcept {
+		return lastFrame;
+	}
+
+	void addBatchView(bool merged) noexcept {
+		batchViews.fetch_add(1, std::memory_order_relaxed);
+		if (merged) {
+			mergedBatchViews.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void newFrame() noexcept {
+		currentFrame.batchViews += batchViews.exchange(0, std::memory_order_relaxed);
+		currentFrame.mergedBatchViews += mergedBatchViews.exchange(0, std::memory_order_relaxed);
+		lastFrame = currentFrame;
+		currentFrame = {};
+	}
+
+	void showWindow(bool& open) {
+		ImGui::SetNextWindowBgAlpha(0.7f);
+		ImGui::Window("Render Stats", &open, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav, [&]() {
+			const auto& stats = lastFrame;
+			ImGui::Text("Draw calls:        %d", stats.drawCalls);
+			ImGui::Text("Texture binds:     %d", stats.textureBinds);
+			ImGui::Text("Program switches:  %d", stats.programSwitches);
+			ImGui::Text("VAO binds:         %d", stats.vertexArrayBinds);
+			ImGui::Text("Matrix uploads:    %d", stats.matrixUploads);
+			ImGui::Text("Vertexes:          %lld", static_cast<long long>(stats.vertexes));
+			ImGui::Text("Indexes:           %lld", static_cast<long long>(stats.indexes));
+			ImGui::Text("Uploaded:          %.1f KiB", stats.bytesUploaded / 1024.0);
+			ImGui::Text("bufferData:        %d", stats.bufferDataCalls);
+			ImGui::Text("bufferSubData:     %d", stats.bufferSubDataCalls);
+			ImGui::Text("Batch views:       %d", stats.batchViews);
+			ImGui::Text("Merge hit rate:    %.1f %%", 100.f * stats.getMergeHitRate());
+		});
+	}
+
+}
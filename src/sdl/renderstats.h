@@ -0,0 +1,55 @@
+#ifndef CPPSDL2_SDL_RENDERSTATS_H
+#define CPPSDL2_SDL_RENDERSTATS_H
+
+#include <cstdint>
+
+namespace sdl {
+
+	// Counters for one frame, updated by the batches, vertex buffers, Graphic and the glstate cache.
+	struct RenderStats {
+		int drawCalls = 0;
+		// Binds issued by the glstate cache, i.e. not the skipped redundant ones.
+		int textureBinds = 0;
+		int programSwitches = 0;
+		int vertexArrayBinds = 0;
+		int matrixUploads = 0;
+		std::int64_t vertexes = 0;
+		std::int64_t indexes = 0;
+		std::int64_t bytesUploaded = 0;
+		// Calls to glBufferData, i.e. buffers (re)allocated.
+		int bufferDataCalls = 0;
+		int bufferSubDataCalls = 0;
+		// Batch views added to Graphic, and how many of them merged with the previous view.
+		int batchViews = 0;
+		int mergedBatchViews = 0;
+
+		// Return the fraction of batch views merged, i.e. not resulting in an extra draw call.
+		float getMergeHitRate() const noexcept {
+			return batchViews > 0 ? static_cast<float>(mergedBatchViews) / batchViews : 0.f;
+		}
+	};
+
+	namespace renderstats {
+
+		// Return the counters for the current frame. Must only be used on the thread owning the
+		// OpenGL context, i.e. the render thread when the window loop is threaded.
+		RenderStats& current() noexcept;
+
+		// Count a batch view added to Graphic, thread safe, i.e. Graphic may be filled on the update thread.
+		void addBatchView(bool merged) noexcept;
+
+		// Return the counters for the last finished frame.
+		const RenderStats& getLastFrame() noexcept;
+
+		// Store the current counters as the last frame and reset them. Called by the
+		// window loop each frame.
+		void newFrame() noexcept;
+
+		// Show an ImGui overlay with the counters of the last frame.
+		void showWindow(bool& open);
+
+	}
+
+}
+
+#endif
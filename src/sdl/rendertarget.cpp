@@ -0,0 +1,138 @@
+#include "rendertarget.h"
+#include "colorpipeline.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace sdl {
+
+	void RenderTarget::resize(int width, int height) {
+		if (width <= 0 || height <= 0) {
+			spdlog::warn("[sdl::RenderTarget] Invalid size {}x{}", width, height);
+			return;
+		}
+		if (isValid() && width == width_ && height == height_) {
+			return;
+		}
+		width_ = width;
+		height_ = height;
+		dirty_ = true;
+
+		gl::GLint previousFrameBuffer = 0;
+		gl::glGetIntegerv(gl::GL_FRAMEBUFFER_BINDING, &previousFrameBuffer);
+
+		texture_ = Texture{};
+		texture_.generate();
+		texture_.texImage(width_, height_);
+
+		if (!frameBuffer_.isValid()) {
+			frameBuffer_.generate();
+		}
+		frameBuffer_.attachTexture(texture_);
+		frameBuffer_.checkStatus();
+		createMultisampleBuffer();
+
+		gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, previousFrameBuffer);
+	}
+
+	void RenderTarget::resize(const Window& window) {
+		auto size = window.getDrawableSize();
+		resize(size.width, size.height);
+	}
+
+	void RenderTarget::draw(Graphic& graphic, const glm::vec2& pos, const glm::vec2& size, Color color) const {
+		if (isValid()) {
+			graphic.addRectangleImage(pos, size, getTextureView(), color);
+		}
+	}
+
+	TextureView RenderTarget::getTextureView() const noexcept {
+		// The frame buffer stores the first row at the bottom.
+		return {texture_, 0.f, 1.f, 1.f, -1.f};
+	}
+
+	void RenderTarget::setSamples(int samples) {
+		requestedSamples_ = std::clamp(samples, 0, RenderBuffer::getMaxSamples());
+		updateSamples(requestedSamples_);
+	}
+
+	void RenderTarget::adaptSamples(const DeltaTime& frameTime, const DeltaTime& budget) {
+		if (frameTime > budget) {
+			underBudgetFrames_ = 0;
+			if (++overBudgetFrames_ >= FramesBeforeLowering && samples_ > 1) {
+				overBudgetFrames_ = 0;
+				updateSamples(samples_ / 2);
+				spdlog::info("[sdl::RenderTarget] Frame time over budget, lowered samples to {}", samples_);
+			}
+		} else if (frameTime * 4 < budget * 3) {
+			overBudgetFrames_ = 0;
+			if (++underBudgetFrames_ >= FramesBeforeRaising && samples_ < requestedSamples_) {
+				underBudgetFrames_ = 0;
+				updateSamples(std::min(std::max(samples_ * 2, 2), requestedSamples_));
+				spdlog::info("[sdl::RenderTarget] Frame time under budget, raised samples to {}", samples_);
+			}
+		} else {
+			overBudgetFrames_ = 0;
+			underBudgetFrames_ = 0;
+		}
+	}
+
+	void RenderTarget::updateSamples(int samples) {
+		samples = samples > 1 ? samples : 0;
+		if (samples == samples_) {
+			return;
+		}
+		samples_ = samples;
+		dirty_ = true;
+		if (isValid()) {
+			gl::GLint previousFrameBuffer = 0;
+			gl::glGetIntegerv(gl::GL_FRAMEBUFFER_BINDING, &previousFrameBuffer);
+			createMultisampleBuffer();
+			gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, previousFrameBuffer);
+		}
+	}
+
+	void RenderTarget::createMultisampleBuffer() {
+		multisampleColor_ = RenderBuffer{};
+		if (samples_ <= 1) {
+			multisampleFrameBuffer_ = FrameBuffer{};
+			return;
+		}
+		multisampleColor_.generate();
+		// The same format as the resolve texture, i.e. sRGB if the color pipeline is linear.
+		multisampleColor_.storage(colorpipeline::getInternalFormat(gl::GL_RGBA8), width_, height_, samples_);
+		samples_ = multisampleColor_.getSamples();
+
+		if (!multisampleFrameBuffer_.isValid()) {
+			multisampleFrameBuffer_.generate();
+		}
+		multisampleFrameBuffer_.attachRenderBuffer(multisampleColor_);
+		multisampleFrameBuffer_.checkStatus();
+	}
+
+	void RenderTarget::begin() {
+		gl::glGetIntegerv(gl::GL_FRAMEBUFFER_BINDING, &previousFrameBuffer_);
+		gl::glGetIntegerv(gl::GL_VIEWPORT, previousViewport_.data());
+		gl::glGetFloatv(gl::GL_COLOR_CLEAR_VALUE, previousClearColor_.data());
+
+		if (multisampleFrameBuffer_.isValid()) {
+			multisampleFrameBuffer_.bind();
+		} else {
+			frameBuffer_.bind();
+		}
+		gl::glViewport(0, 0, width_, height_);
+		gl::glClearColor(clearColor_.red(), clearColor_.green(), clearColor_.blue(), clearColor_.alpha());
+		gl::glClear(gl::GL_COLOR_BUFFER_BIT);
+	}
+
+	void RenderTarget::end() {
+		if (multisampleFrameBuffer_.isValid()) {
+			multisampleFrameBuffer_.blit(frameBuffer_, width_, height_);
+		}
+		gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, previousFrameBuffer_);
+		gl::glViewport(previousViewport_[0], previousViewport_[1], previousViewport_[2], previousViewport_[3]);
+		gl::glClearColor(previousClearColor_[0], previousClearColor_[1], previousClearColor_[2], previousClearColor_[3]);
+	}
+
+}
@@ -0,0 +1,150 @@
+#ifndef CPPSDL2_SDL_RENDERTARGET_H
+#define CPPSDL2_SDL_RENDERTARGET_H
+
+#include "color.h"
+#include "framebuffer.h"
+#include "graphic.h"
+#include "renderbuffer.h"
+#include "texture.h"
+#include "textureview.h"
+#include "window.h"
+
+#include <glm/vec2.hpp>
+
+#include <array>
+
+namespace sdl {
+
+	// A texture rendered to by a frame buffer. Used to cache rarely changing layers,
+	// which are only rendered again when invalidated and composited as one textured quad.
+	// With multisampling the content is rendered to a multisampled render buffer and
+	// resolved to the texture, e.g. the game scene with 4x MSAA and ImGui at 1x.
+	class RenderTarget {
+	public:
+		RenderTarget() = default;
+
+		RenderTarget(const RenderTarget&) = delete;
+		RenderTarget& operator=(const RenderTarget&) = delete;
+
+		RenderTarget(RenderTarget&&) noexcept = default;
+		RenderTarget& operator=(RenderTarget&&) noexcept = default;
+
+		// Resize the target in pixels, the target is invalidated if the size changes.
+		void resize(int width, int height);
+
+		// Resize the target to the size of the window's drawable area.
+		void resize(const Window& window);
+
+		// The next call to render() renders the content again.
+		void invalidate() noexcept;
+
+		bool isDirty() const noexcept;
+
+		// Render to the texture if the target is invalidated, return true if rendered.
+		// The previous frame buffer, viewport and clear color are restored afterwards.
+		bool render(std::invocable auto&& renderFunction);
+
+		// Render to the texture whether invalidated or not.
+		void forceRender(std::invocable auto&& renderFunction);
+
+		// Add the texture as one quad to the graphic.
+		void draw(Graphic& graphic, const glm::vec2& pos, const glm::vec2& size, Color color = color::White) const;
+
+		// Return a view of the whole texture, flipped in order to be upright when drawn.
+		TextureView getTextureView() const noexcept;
+
+		void setClearColor(Color color) noexcept;
+
+		// Set the number of samples used for multisampling, zero or one turns it off.
+		// Clamped to the maximum supported by the context. The target is invalidated.
+		void setSamples(int samples);
+
+		// Return the number of samples currently used.
+		int getSamples() const noexcept;
+
+		// Lower the samples when the frame time stays over budget, and restore them
+		// when it stays well below. Call once per frame.
+		void adaptSamples(const DeltaTime& frameTime, const DeltaTime& budget);
+
+		int getWidth() const noexcept;
+
+		int getHeight() const noexcept;
+
+		bool isValid() const noexcept;
+
+	private:
+		static constexpr int FramesBeforeLowering = 30;
+		static constexpr int FramesBeforeRaising = 300;
+
+		void begin();
+		void end();
+		void updateSamples(int samples);
+		void createMultisampleBuffer();
+
+		FrameBuffer frameBuffer_;
+		Texture texture_;
+		FrameBuffer multisampleFrameBuffer_;
+		RenderBuffer multisampleColor_;
+		std::array<gl::GLint, 4> previousViewport_{};
+		std::array<gl::GLfloat, 4> previousClearColor_{};
+		gl::GLint previousFrameBuffer_ = 0;
+		Color clearColor_ = color::Transparent;
+		int width_ = 0;
+		int height_ = 0;
+		int requestedSamples_ = 0;
+		int samples_ = 0;
+		int overBudgetFrames_ = 0;
+		int underBudgetFrames_ = 0;
+		bool dirty_ = true;
+	};
+
+	bool RenderTarget::render(std::invocable auto&& renderFunction) {
+		if (!dirty_) {
+			return false;
+		}
+		forceRender(renderFunction);
+		return true;
+	}
+
+	void RenderTarget::forceRender(std::invocable auto&& renderFunction) {
+		if (!isValid()) {
+			spdlog::warn("[sdl::RenderTarget] Failed to render, must be resized first");
+			return;
+		}
+		begin();
+		renderFunction();
+		end();
+		dirty_ = false;
+	}
+
+	inline void RenderTarget::invalidate() noexcept {
+		dirty_ = true;
+	}
+
+	inline bool RenderTarget::isDirty() const noexcept {
+		return dirty_;
+	}
+
+	inline void RenderTarget::setClearColor(Color color) noexcept {
+		clearColor_ = color;
+	}
+
+	inline int RenderTarget::getSamples() const noexcept {
+		return samples_;
+	}
+
+	inline int RenderTarget::getWidth() const noexcept {
+		return width_;
+	}
+
+	inline int RenderTarget::getHeight() const noexcept {
+		return height_;
+	}
+
+	inline bool RenderTarget::isValid() const noexcept {
+		return frameBuffer_.isValid() && texture_.isValid();
+	}
+
+}
+
+#endif
@@ -9,13 +9,13 @@ namespace sdl {
 
 	namespace {
 
-		constexpr const gl::GLchar* aPos = "aPos";
-		constexpr const gl::GLchar* aTex = "aTex";
-		constexpr const gl::GLchar* aCol = "aColor";
+		constexpr ShaderName aPos{"aPos"};
+		constexpr ShaderName aTex{"aTex"};
+		constexpr ShaderName aCol{"aColor"};
 
-		constexpr const gl::GLchar* uMat = "uMat";
-		constexpr const gl::GLchar* uTexture = "uTexture";
-		constexpr const gl::GLchar* uUseTexture = "uUseTexture";
+		constexpr ShaderName uMat{"uMat"};
+		constexpr ShaderName uTexture{"uTexture"};
+		constexpr ShaderName uUseTexture{"uUseTexture"};
 
 		constexpr void vertexEqualImDrawVert() {
 			static_assert(sizeof(ImDrawVert::col) == sizeof(Vertex::color));
@@ -60,18 +60,119 @@ void main() {
 }
 )";
 
+		constexpr const gl::GLchar* VertexShaderPermutationGlsl_330 =
+R"(
+uniform mat4 uMat;
+
+in vec2 aPos;
+in vec2 aTex;
+in vec4 aColor;
+
+#ifdef TEXTURED
+out vec2 fragTex;
+#endif
+#ifdef VERTEX_COLOR
+out vec4 fragColor;
+#endif
+
+void main() {
+#ifdef TEXTURED
+	fragTex = aTex;
+#endif
+#ifdef VERTEX_COLOR
+	fragColor = aColor;
+#ifdef LINEAR_COLOR
+	fragColor.rgb = mix(aColor.rgb / 12.92, pow((aColor.rgb + 0.055) / 1.055, vec3(2.4)), step(0.04045, aColor.rgb));
+#endif
+#ifdef PREMULTIPLIED_ALPHA
+	fragColor.rgb *= fragColor.a;
+#endif
+#endif
+	gl_Position = uMat * vec4(aPos.xy, 0, 1);
+	gl_PointSize = aTex.x;
+}
+)";
+
+		constexpr const gl::GLchar* FragmentShaderPermutationGlsl_330 =
+R"(
+#ifdef TEXTURED
+uniform sampler2D uTexture;
+in vec2 fragTex;
+#endif
+#ifdef VERTEX_COLOR
+in vec4 fragColor;
+#endif
+
+out vec4 oColor;
+
+void main() {
+#ifdef VERTEX_COLOR
+	vec4 color = fragColor;
+#else
+	vec4 color = vec4(1.0);
+#endif
+#if defined(TEXTURED) && defined(SDF)
+	float distance = texture(uTexture, fragTex.st).a;
+	float width = fwidth(distance);
+#ifdef PREMULTIPLIED_ALPHA
+	color *= smoothstep(0.5 - width, 0.5 + width, distance);
+#else
+	color.a *= smoothstep(0.5 - width, 0.5 + width, distance);
+#endif
+#elif defined(TEXTURED)
+	color *= texture(uTexture, fragTex.st);
+#endif
+#ifdef ALPHA_TEST
+	if (color.a < 0.5) {
+		discard;
+	}
+#endif
+	oColor = color;
+}
+)";
+
+		std::string createSource(ShaderFeatures features, const gl::GLchar* source) {
+			std::string code = "#version 330 core\n";
+			if (hasFeatures(features, ShaderFeatures::Textured)) {
+				code += "#define TEXTURED\n";
+			}
+			if (hasFeatures(features, ShaderFeatures::VertexColor)) {
+				code += "#define VERTEX_COLOR\n";
+			}
+			if (hasFeatures(features, ShaderFeatures::AlphaTest)) {
+				code += "#define ALPHA_TEST\n";
+			}
+			if (hasFeatures(features, ShaderFeatures::Sdf)) {
+				code += "#define SDF\n";
+			}
+			if (hasFeatures(features, ShaderFeatures::LinearColor)) {
+				code += "#define LINEAR_COLOR\n";
+			}
+			if (hasFeatures(features, ShaderFeatures::PremultipliedAlpha)) {
+				code += "#define PREMULTIPLIED_ALPHA\n";
+			}
+			return code += source;
+		}
+
 	}
 
 	Shader Shader::CreateShaderGlsl_330() {
 		return Shader{VertexShaderGlsl_330, FragmentShaderGlsl_330};
 	}
 
-	Shader::Shader(const gl::GLchar* vShade, const gl::GLchar* fShader) {
+	Shader Shader::CreateShaderGlsl_330(ShaderFeatures features) {
+		return Shader{
+			createSource(features, VertexShaderPermutationGlsl_330),
+			createSource(features, FragmentShaderPermutationGlsl_330)
+		};
+	}
+
+	Shader::Shader(const std::string& vShader, const std::string& fShader) {
 		shader_.bindAttribute(aPos);
 		shader_.bindAttribute(aTex);
 		shader_.bindAttribute(aCol);
 
-		if (shader_.loadAndLink(vShade, fShader)) {
+		if (shader_.loadAndLink(vShader, fShader)) {
 			// Collect the vertex buffer attributes indexes.
 			aPos_ = shader_.getAttributeLocation(aPos);
 			aTex_ = shader_.getAttributeLocation(aTex);
@@ -110,6 +211,7 @@ void main() {
 	}
 
 	void Shader::setTextureId(int textureId) {
+		// Uniforms missing in a permutation have location -1, which gl ignores.
 		if (textureId < 0) {
 			gl::glUniform1f(uUseTexture_, 0.f);
 		} else {
@@ -5,14 +5,44 @@
 
 #include <glm/mat4x2.hpp>
 
+#include <string>
+
 namespace sdl {
 
+	// Compile time features of a shader permutation, each one a define in the GLSL source.
+	enum class ShaderFeatures : unsigned {
+		None = 0,
+		Textured = 1 << 0,		// TEXTURED, multiply with the texture sample.
+		VertexColor = 1 << 1,	// VERTEX_COLOR, use the vertex color, else white.
+		AlphaTest = 1 << 2,		// ALPHA_TEST, discard fragments with alpha below 0.5.
+		Sdf = 1 << 3,			// SDF, the texture alpha is a signed distance field.
+		LinearColor = 1 << 4,	// LINEAR_COLOR, convert the sRGB vertex color to linear.
+		PremultipliedAlpha = 1 << 5,	// PREMULTIPLIED_ALPHA, premultiply the vertex color with its alpha.
+		All = Textured | VertexColor | AlphaTest | Sdf | LinearColor | PremultipliedAlpha
+	};
+
+	constexpr ShaderFeatures operator|(ShaderFeatures left, ShaderFeatures right) noexcept {
+		return static_cast<ShaderFeatures>(static_cast<unsigned>(left) | static_cast<unsigned>(right));
+	}
+
+	constexpr ShaderFeatures operator&(ShaderFeatures left, ShaderFeatures right) noexcept {
+		return static_cast<ShaderFeatures>(static_cast<unsigned>(left) & static_cast<unsigned>(right));
+	}
+
+	constexpr bool hasFeatures(ShaderFeatures features, ShaderFeatures required) noexcept {
+		return (features & required) == required;
+	}
+
 	class Shader {
 	public:
 		Shader() = default;
 
+		// The general shader, choosing between texture and color with a uniform.
 		static Shader CreateShaderGlsl_330();
 
+		// A specialized shader, only paying for the features used.
+		static Shader CreateShaderGlsl_330(ShaderFeatures features);
+
 		Shader(const Shader&) = delete;
 		Shader& operator=(const Shader&) = delete;
 
@@ -27,8 +57,12 @@ namespace sdl {
 
 		void setTextureId(int textureId);
 
+		bool isLinked() const noexcept {
+			return shader_.isLinked();
+		}
+
 	private:
-		Shader(const gl::GLchar* vShade, const gl::GLchar* fShader);
+		Shader(const std::string& vShader, const std::string& fShader);
 
 		sdl::ShaderProgram shader_;
 		
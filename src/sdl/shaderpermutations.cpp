@@ -0,0 +1,28 @@
+#include "shaderpermutations.h"
+
+#include <spdlog/spdlog.h>
+
+namespace sdl {
+
+	Shader& ShaderPermutations::get(ShaderFeatures features) {
+		auto& shader = shaders_[static_cast<std::size_t>(features & ShaderFeatures::All)];
+		if (!shader) {
+			spdlog::debug("[sdl::ShaderPermutations] compile permutation {:#x}", static_cast<unsigned>(features));
+			shader = std::make_unique<Shader>(Shader::CreateShaderGlsl_330(features));
+		}
+		return *shader;
+	}
+
+	void ShaderPermutations::preload(std::initializer_list<ShaderFeatures> features) {
+		for (auto feature : features) {
+			get(feature);
+		}
+	}
+
+	void ShaderPermutations::clear() {
+		for (auto& shader : shaders_) {
+			shader.reset();
+		}
+	}
+
+}
@@ -0,0 +1,47 @@
+#ifndef CPPSDL2_SDL_SHADERPERMUTATIONS_H
+#define CPPSDL2_SDL_SHADERPERMUTATIONS_H
+
+#include "shader.h"
+
+#include <array>
+#include <initializer_list>
+#include <memory>
+
+namespace sdl {
+
+	// Cache of specialized shaders, one per combination of features, compiled on first use.
+	// The attribute locations are the same in all permutations, i.e. they share vertex array objects.
+	class ShaderPermutations {
+	public:
+		ShaderPermutations() = default;
+
+		ShaderPermutations(const ShaderPermutations&) = delete;
+		ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+		ShaderPermutations(ShaderPermutations&& other) noexcept = default;
+		ShaderPermutations& operator=(ShaderPermutations&& other) noexcept = default;
+
+		// Return the shader with the features, compiles it if not already done.
+		Shader& get(ShaderFeatures features);
+
+		// Return true if the shader with the features is already compiled.
+		bool contains(ShaderFeatures features) const noexcept;
+
+		// Compile the shaders in advance, e.g. during loading, to avoid stalls in the first frames.
+		void preload(std::initializer_list<ShaderFeatures> features);
+
+		void clear();
+
+	private:
+		static constexpr auto Size = static_cast<std::size_t>(ShaderFeatures::All) + 1;
+
+		std::array<std::unique_ptr<Shader>, Size> shaders_;
+	};
+
+	inline bool ShaderPermutations::contains(ShaderFeatures features) const noexcept {
+		return shaders_[static_cast<std::size_t>(features & ShaderFeatures::All)] != nullptr;
+	}
+
+}
+
+#endif
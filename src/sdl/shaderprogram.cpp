@@ -1,9 +1,14 @@
 #include "shaderprogram.h"
+#include "glstate.h"
+#include "hash.h"
+
+#include <glm/gtc/type_ptr.hpp>
 
 #include <spdlog/spdlog.h>
 
+#include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <vector>
 
 namespace sdl {
 
@@ -34,160 +39,435 @@ namespace sdl {
 			}
 		}
 
+		// The compile status is not checked, in order to not wait for the compilation.
 		gl::GLuint loadShader(gl::GLuint program, gl::GLenum type, const gl::GLchar* shaderSrc) {
-			auto shader= glCreateShader(type);
+			auto shader = gl::glCreateShader(type);
 			if (shader == 0) {
-				spdlog::error("[sdl::ShaderProgram] Failed to create shader: ", shaderSrc);
+				spdlog::error("[sdl::ShaderProgram] Failed to create shader: {}", shaderSrc);
 				return 0;
 			}
 			gl::glShaderSource(shader, 1, &shaderSrc, nullptr);
 			gl::glCompileShader(shader);
+			gl::glAttachShader(program, shader);
+			return shader;
+		}
 
-			gl::GLint compileStatus;
+		void logShaderErrors(gl::GLuint shader) {
+			gl::GLint compileStatus = 0;
 			gl::glGetShaderiv(shader, gl::GL_COMPILE_STATUS, &compileStatus);
 			if (!compileStatus) {
-				logError<LogError::ShaderError>(shader, shaderSrc, "Failed to compile shader: ");
-				return 0;
+				logError<LogError::ShaderError>(shader, "", "Failed to compile shader");
 			}
-			gl::glAttachShader(program, shader);
-			return shader;
 		}
 
+		bool isParallelCompileSupported() {
+			static const bool supported = isExtensionSupported("GL_KHR_parallel_shader_compile");
+			return supported;
+		}
+
+		std::filesystem::path binaryCacheDirectory;
+
 		std::string loadFromFile(const std::string& file) {
 			if (file.empty()) {
 				return "";
 			}
-			std::ifstream inFile{file};
-			std::stringstream stream;
-			stream << inFile.rdbuf();
-			return stream.str();
+			std::ifstream inFile{file, std::ios::binary | std::ios::ate};
+			if (!inFile) {
+				spdlog::warn("[sdl::ShaderProgram] Failed to open {}", file);
+				return "";
+			}
+			std::string content(static_cast<std::size_t>(inFile.tellg()), '\0');
+			inFile.seekg(0);
+			inFile.read(content.data(), content.size());
+			return content;
+		}
+
+		bool isProgramBinarySupported() {
+			gl::GLint formats = 0;
+			gl::glGetIntegerv(gl::GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			return formats > 0;
+		}
+
+		std::string_view glString(gl::GLenum name) {
+			auto str = reinterpret_cast<const char*>(gl::glGetString(name));
+			return str != nullptr ? str : "";
 		}
 
 	}
 
 	ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept :
 		attributes_{std::move(other.attributes_)},
-		uniforms_{std::move(other.uniforms_)},
-		programObjectId_{std::exchange(other.programObjectId_, 0)} {
+		reflection_{std::move(other.reflection_)},
+		shaders_{std::move(other.shaders_)},
+		cacheFile_{std::move(other.cacheFile_)},
+		vShaderFile_{std::move(other.vShaderFile_)},
+		gShaderFile_{std::move(other.gShaderFile_)},
+		fShaderFile_{std::move(other.fShaderFile_)},
+		watcher_{std::move(other.watcher_)},
+		programObjectId_{std::exchange(other.programObjectId_, 0)},
+		pending_{std::exchange(other.pending_, false)} {
 	}
 
 	ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
+		deleteShaders();
 		if (programObjectId_ != 0) {
+			glstate::forgetProgram(programObjectId_);
 			gl::glDeleteProgram(programObjectId_);
 		}
 		
 		attributes_ = std::move(other.attributes_);
-		uniforms_ = std::move(other.uniforms_);
+		reflection_ = std::move(other.reflection_);
+		shaders_ = std::move(other.shaders_);
+		cacheFile_ = std::move(other.cacheFile_);
+		vShaderFile_ = std::move(other.vShaderFile_);
+		gShaderFile_ = std::move(other.gShaderFile_);
+		fShaderFile_ = std::move(other.fShaderFile_);
+		watcher_ = std::move(other.watcher_);
 		programObjectId_ = std::exchange(other.programObjectId_, 0);
+		pending_ = std::exchange(other.pending_, false);
 		return *this;
 	}
 
 	ShaderProgram::~ShaderProgram() {
+		deleteShaders();
 		if (programObjectId_ != 0) {
+			glstate::forgetProgram(programObjectId_);
 			gl::glDeleteProgram(programObjectId_);
 		}
 	}
 
-	void ShaderProgram::bindAttribute(const std::string& attribute) {
+	void ShaderProgram::bindAttribute(ShaderName attribute) {
 		if (programObjectId_ == 0) {
-			attributes_[attribute] = 0;
+			attributes_[std::string{attribute.getName()}] = 0;
 		} else {
 			spdlog::warn("[sdl::ShaderProgram] Failed to bind attribute, program is already compiled");
 		}
 	}
 
-	int ShaderProgram::getAttributeLocation(const std::string& attribute) const {
-		auto it = attributes_.find(attribute);
-		if (it != attributes_.end()) {
+	int ShaderProgram::getAttributeLocation(ShaderName attribute) const {
+		if (auto variable = reflection_.getAttributes().find(attribute); variable) {
+			return variable->location;
+		}
+		// Bound but not active.
+		if (auto it = attributes_.find(attribute.getName()); it != attributes_.end()) {
 			return it->second;
 		}
-		spdlog::warn("[sdl::ShaderProgram] shader attribute {} failed to be extracted", attribute);
+		spdlog::warn("[sdl::ShaderProgram] shader attribute {} failed to be extracted", attribute.getName());
 		return -1;
 	}
 
-	int ShaderProgram::getUniformLocation(const std::string& uniform) const {
-		if (programObjectId_ == 0) {
-			spdlog::warn("[sdl::ShaderProgram] shader uniform {} failed to be extracted", uniform);
+	int ShaderProgram::getUniformLocation(ShaderName uniform) const {
+		if (!isLinked()) {
+			spdlog::warn("[sdl::ShaderProgram] shader uniform {} failed to be extracted", uniform.getName());
 			return -1;
 		}
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			return variable->location;
+		}
+		return -1;
+	}
 
-		if (auto it = uniforms_.find(uniform); 
-			it != uniforms_.end()) {
-			
-			return it->second;
+	int ShaderProgram::getUniformBlockIndex(ShaderName uniformBlock) const {
+		if (auto variable = reflection_.getUniformBlocks().find(uniformBlock); variable) {
+			return variable->location;
+		}
+		return -1;
+	}
+
+	void ShaderProgram::setUniform(ShaderName uniform, int value) const {
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			gl::glUniform1i(variable->location, value);
+		}
+	}
+
+	void ShaderProgram::setUniform(ShaderName uniform, float value) const {
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			gl::glUniform1f(variable->location, value);
 		}
+	}
+
+	void ShaderProgram::setUniform(ShaderName uniform, const glm::vec2& value) const {
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			gl::glUniform2f(variable->location, value.x, value.y);
+		}
+	}
 
-		auto loc = gl::glGetUniformLocation(programObjectId_, uniform.c_str());
-		if (loc != -1) {
-			uniforms_[uniform] = loc;
+	void ShaderProgram::setUniform(ShaderName uniform, const glm::vec3& value) const {
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			gl::glUniform3f(variable->location, value.x, value.y, value.z);
+		}
+	}
+
+	void ShaderProgram::setUniform(ShaderName uniform, const glm::vec4& value) const {
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			gl::glUniform4f(variable->location, value.x, value.y, value.z, value.w);
+		}
+	}
+
+	void ShaderProgram::setUniform(ShaderName uniform, const glm::mat4& value) const {
+		if (auto variable = reflection_.getUniforms().find(uniform); variable) {
+			gl::glUniformMatrix4fv(variable->location, 1, gl::GL_FALSE, glm::value_ptr(value));
 		}
-		return loc;
 	}
 
 	bool ShaderProgram::loadAndLinkFromFile(const std::string& vShaderFile, const std::string& gShaderFile, const std::string& fShaderFile) {
-		return loadAndLink(loadFromFile(vShaderFile), loadFromFile(gShaderFile), loadFromFile(fShaderFile));
+		if (!loadAndLink(loadFromFile(vShaderFile), loadFromFile(gShaderFile), loadFromFile(fShaderFile))) {
+			return false;
+		}
+		vShaderFile_ = vShaderFile;
+		gShaderFile_ = gShaderFile;
+		fShaderFile_ = fShaderFile;
+		if (watcher_) {
+			setHotReload(true);
+		}
+		return true;
 	}
 
 	bool ShaderProgram::loadAndLinkFromFile(const std::string& vShaderFile, const std::string& fShaderFile) {
 		return loadAndLinkFromFile(vShaderFile, "", fShaderFile);
 	}
 
+	void ShaderProgram::setHotReload(bool hotReload) {
+		if (!hotReload) {
+			watcher_.reset();
+			return;
+		}
+		watcher_ = std::make_unique<FileWatcher>();
+		for (const auto& file : {vShaderFile_, gShaderFile_, fShaderFile_}) {
+			if (!file.empty()) {
+				watcher_->add(file);
+			}
+		}
+	}
+
+	bool ShaderProgram::reloadIfChanged() {
+		if (!watcher_ || !watcher_->poll() || vShaderFile_.empty()) {
+			return false;
+		}
+		ShaderProgram program;
+		for (const auto& [name, location] : attributes_) {
+			program.attributes_[name] = 0;
+		}
+		if (!program.loadAndLinkFromFile(vShaderFile_, gShaderFile_, fShaderFile_)) {
+			spdlog::warn("[sdl::ShaderProgram] Failed to reload {}, keeps the old program", vShaderFile_);
+			return false;
+		}
+		auto watcher = std::move(watcher_);
+		*this = std::move(program);
+		watcher_ = std::move(watcher);
+		spdlog::info("[sdl::ShaderProgram] Reloaded {}", vShaderFile_);
+		return true;
+	}
+
+	void ShaderProgram::setBinaryCacheDirectory(const std::string& directory) {
+		binaryCacheDirectory = directory;
+	}
+
 	bool ShaderProgram::loadAndLink(const std::string& vShader, const std::string& gShader, const std::string& fShader) {
+		if (!loadAndLinkAsync(vShader, gShader, fShader)) {
+			return false;
+		}
+		return finishLink();
+	}
+
+	bool ShaderProgram::loadAndLink(const std::string& vShader, const std::string& fShader) {
+		return loadAndLink(vShader, "", fShader);
+	}
+
+	bool ShaderProgram::loadAndLinkAsync(const std::string& vShader, const std::string& gShader, const std::string& fShader) {
 		if (programObjectId_ != 0) {
 			spdlog::warn("[sdl::ShaderProgram] Failed to load and link, opengl program already generated");
 			return false;
 		}
+
+		cacheFile_.clear();
+		if (!binaryCacheDirectory.empty() && isProgramBinarySupported()) {
+			auto cacheFile = (binaryCacheDirectory / fmt::format("{:016x}.bin", hashProgram(vShader, gShader, fShader))).string();
+			if (loadBinary(cacheFile)) {
+				return true;
+			}
+			cacheFile_ = cacheFile;
+		}
 		
 		programObjectId_ = gl::glCreateProgram();
-			
 		if (programObjectId_ == 0) {
 			spdlog::error("[sdl::ShaderProgram] Failed to create program");
 			return false;
 		}
 
-		if (0 == loadShader(programObjectId_, gl::GL_VERTEX_SHADER, vShader.c_str())) {
-			return false;
-		}
-		if (!gShader.empty() && 0 == loadShader(programObjectId_, gl::GL_GEOMETRY_SHADER, gShader.c_str())) {
-			return false;
-		}
-		if (0 == loadShader(programObjectId_, gl::GL_FRAGMENT_SHADER, fShader.c_str())) {
-            return false;
+		for (auto [type, source] : {std::pair{gl::GL_VERTEX_SHADER, &vShader}, std::pair{gl::GL_GEOMETRY_SHADER, &gShader}, std::pair{gl::GL_FRAGMENT_SHADER, &fShader}}) {
+			if (type == gl::GL_GEOMETRY_SHADER && source->empty()) {
+				continue;
+			}
+			auto shader = loadShader(programObjectId_, type, source->c_str());
+			if (shader == 0) {
+				deleteShaders();
+				gl::glDeleteProgram(programObjectId_);
+				programObjectId_ = 0;
+				return false;
+			}
+			shaders_.push_back(shader);
 		}
 
 		bindAllAttributes();
 
+		if (!cacheFile_.empty()) {
+			gl::glProgramParameteri(programObjectId_, gl::GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+		}
+		gl::glLinkProgram(programObjectId_);
+		pending_ = true;
+		return true;
+	}
+
+	bool ShaderProgram::loadAndLinkAsync(const std::string& vShader, const std::string& fShader) {
+		return loadAndLinkAsync(vShader, "", fShader);
+	}
+
+	bool ShaderProgram::isLinkFinished() const {
+		if (!pending_ || !isParallelCompileSupported()) {
+			return true;
+		}
+		gl::GLint completed = 0;
+		gl::glGetProgramiv(programObjectId_, gl::GL_COMPLETION_STATUS_KHR, &completed);
+		return completed != 0;
+	}
+
+	bool ShaderProgram::finishLink() {
+		if (!pending_) {
+			// E.g. loaded from the binary cache.
+			if (isLinked()) {
+				useProgram();
+				return true;
+			}
+			return false;
+		}
+		pending_ = false;
 		if (!linkProgram()) {
 			return false;
 		}
+		deleteShaders();
+		reflection_.reflect(programObjectId_);
+		if (!cacheFile_.empty()) {
+			saveBinary(cacheFile_);
+		}
 
 		useProgram();
 		return true;
 	}
 
-	bool ShaderProgram::loadAndLink(const std::string& vShader, const std::string& fShader) {
-		return loadAndLink(vShader, "", fShader);
+	void ShaderProgram::setMaxCompilerThreads(int threads) {
+		if (isParallelCompileSupported()) {
+			gl::glMaxShaderCompilerThreadsKHR(static_cast<gl::GLuint>(threads));
+		}
 	}
 
 	void ShaderProgram::useProgram() {
-		if (programObjectId_ != 0) {
-			gl::glUseProgram(programObjectId_);
+		if (isLinked()) {
+			glstate::useProgram(programObjectId_);
 		} else {
 			spdlog::warn("[sdl::ShaderProgram] Failed to use program, program is not compiled");
 		}
 	}
 	
 	bool ShaderProgram::linkProgram() {
-		gl::glLinkProgram(programObjectId_);
 		gl::GLint linked;
 		gl::glGetProgramiv(programObjectId_, gl::GL_LINK_STATUS, &linked);
 		if (!linked) {
+			for (auto shader : shaders_) {
+				logShaderErrors(shader);
+			}
 			logError<LogError::ProgramError>(programObjectId_, "", "Error linking program");
+			deleteShaders();
+			glstate::forgetProgram(programObjectId_);
 			gl::glDeleteProgram(programObjectId_);
+			programObjectId_ = 0;
 			return false;
 		}
 		return true;
-	}	
+	}
+
+	void ShaderProgram::deleteShaders() {
+		for (auto shader : shaders_) {
+			if (programObjectId_ != 0) {
+				gl::glDetachShader(programObjectId_, shader);
+			}
+			gl::glDeleteShader(shader);
+		}
+		shaders_.clear();
+	}
+
+	bool ShaderProgram::loadBinary(const std::string& file) {
+		std::ifstream inFile{file, std::ios::binary | std::ios::ate};
+		if (!inFile) {
+			return false;
+		}
+		auto size = static_cast<std::size_t>(inFile.tellg());
+		std::uint32_t format = 0;
+		if (size <= sizeof(format)) {
+			return false;
+		}
+		std::vector<char> binary(size - sizeof(format));
+		inFile.seekg(0);
+		inFile.read(reinterpret_cast<char*>(&format), sizeof(format));
+		inFile.read(binary.data(), binary.size());
+		if (!inFile) {
+			return false;
+		}
+
+		programObjectId_ = gl::glCreateProgram();
+		if (programObjectId_ == 0) {
+			spdlog::error("[sdl::ShaderProgram] Failed to create program");
+			return false;
+		}
+		gl::glProgramBinary(programObjectId_, static_cast<gl::GLenum>(format), binary.data(), static_cast<gl::GLsizei>(binary.size()));
+		gl::GLint linked = 0;
+		gl::glGetProgramiv(programObjectId_, gl::GL_LINK_STATUS, &linked);
+		if (!linked) {
+			// E.g. after a driver update.
+			spdlog::info("[sdl::ShaderProgram] Program binary {} rejected, compiles from source", file);
+			gl::glDeleteProgram(programObjectId_);
+			programObjectId_ = 0;
+			return false;
+		}
+		// Linked with the attribute locations bound when saved, the hash includes the attribute names.
+		reflection_.reflect(programObjectId_);
+		spdlog::debug("[sdl::ShaderProgram] Program loaded from binary {}", file);
+		return true;
+	}
+
+	void ShaderProgram::saveBinary(const std::string& file) const {
+		gl::GLint length = 0;
+		gl::glGetProgramiv(programObjectId_, gl::GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) {
+			return;
+		}
+		std::vector<char> binary(length);
+		gl::GLenum format{};
+		gl::glGetProgramBinary(programObjectId_, length, &length, &format, binary.data());
+
+		std::error_code error;
+		std::filesystem::create_directories(binaryCacheDirectory, error);
+		std::ofstream outFile{file, std::ios::binary};
+		auto format32 = static_cast<std::uint32_t>(format);
+		outFile.write(reinterpret_cast<const char*>(&format32), sizeof(format32));
+		outFile.write(binary.data(), length);
+		if (!outFile) {
+			spdlog::warn("[sdl::ShaderProgram] Failed to save program binary {}", file);
+		}
+	}
+
+	std::uint64_t ShaderProgram::hashProgram(const std::string& vShader, const std::string& gShader, const std::string& fShader) const {
+		// A zero byte between the parts, in order to not hash e.g. "ab" + "c" as "a" + "bc".
+		constexpr std::string_view separator{"", 1};
+		auto hash = FnvOffsetBasis;
+		for (std::string_view part : {std::string_view{vShader}, std::string_view{gShader}, std::string_view{fShader}, glString(gl::GL_RENDERER), glString(gl::GL_VERSION)}) {
+			hash = fnv1a(separator, fnv1a(part, hash));
+		}
+		for (const auto& [name, location] : attributes_) {
+			hash = fnv1a(separator, fnv1a(name, hash));
+		}
+		return hash;
+	}
 
 	void ShaderProgram::bindAllAttributes() {
 		int index = 0;
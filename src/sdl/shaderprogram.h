@@ -1,10 +1,20 @@
 #ifndef CPPSDL2_SDL_SHADERPROGRAM_H
 #define CPPSDL2_SDL_SHADERPROGRAM_H
 
+#include "filewatcher.h"
 #include "opengl.h"
+#include "shaderreflection.h"
 
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstdint>
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace sdl {
 
@@ -24,15 +34,31 @@ namespace sdl {
 		// Bind the attribute to the shader.
 		// Must be called before linking the shader in order for the attribute to
 		// be available. I.e. before calling loadAndLinkShadersFromFile(...).
-		void bindAttribute(const std::string& attribute);
+		void bindAttribute(ShaderName attribute);
 
 		// Return the gl memory location for the attribute.
 		// Return -1 on error.
-		int getAttributeLocation(const std::string& attribute) const;
-
-		// Return the gl memory location for the uniform.
-		// Return -1 on error.
-		int getUniformLocation(const std::string& uniform) const;
+		int getAttributeLocation(ShaderName attribute) const;
+
+		// Return the gl memory location for the uniform, looked up in the program reflection
+		// without any gl call. Return -1 on error.
+		int getUniformLocation(ShaderName uniform) const;
+
+		// Return the index of the uniform block, or -1 if not active.
+		int getUniformBlockIndex(ShaderName uniformBlock) const;
+
+		// Set the uniform of the program in use, does nothing if the uniform is not active.
+		void setUniform(ShaderName uniform, int value) const;
+		void setUniform(ShaderName uniform, float value) const;
+		void setUniform(ShaderName uniform, const glm::vec2& value) const;
+		void setUniform(ShaderName uniform, const glm::vec3& value) const;
+		void setUniform(ShaderName uniform, const glm::vec4& value) const;
+		void setUniform(ShaderName uniform, const glm::mat4& value) const;
+
+		// Return the active uniforms, attributes and uniform blocks, collected when linked.
+		const ShaderReflection& getReflection() const noexcept {
+			return reflection_;
+		}
 
 		// Load shaders from files. Is safe to call multiple times but only the 
 		// first successful is "used. Load and link the vertex shader and the 
@@ -50,24 +76,74 @@ namespace sdl {
 
 		[[nodiscard]] bool loadAndLink(const std::string& vShader, const std::string& gShader, const std::string& fShader);
 
+		// Submit the shaders for compilation and linking without waiting for the result, in
+		// order to compile many programs in parallel, e.g. while showing a loading screen.
+		// Poll isLinkFinished() and then call finishLink(). Return false if the submit failed.
+		[[nodiscard]] bool loadAndLinkAsync(const std::string& vShader, const std::string& fShader);
+
+		[[nodiscard]] bool loadAndLinkAsync(const std::string& vShader, const std::string& gShader, const std::string& fShader);
+
+		// Return true if finishLink() will not block. Without GL_KHR_parallel_shader_compile
+		// it is always true, and finishLink() blocks until the driver is done.
+		bool isLinkFinished() const;
+
+		// Check the link status of the submitted program, and use it. Return true if linked.
+		bool finishLink();
+
+		// Set the number of driver threads compiling shaders, if GL_KHR_parallel_shader_compile is supported.
+		static void setMaxCompilerThreads(int threads);
+
 		// Uses the current gl program. I.e. a call to glUseProgram.
 		// Does nothing if the program is not loaded.
 		void useProgram();
 
+		// Cache the linked program binaries in the directory, used by the next load with the same
+		// sources and attributes on the same driver. Falls back to compiling from source if the
+		// driver rejects the binary. An empty directory turns it off, which is the default.
+		static void setBinaryCacheDirectory(const std::string& directory);
+
+		// Watch the files given to loadAndLinkFromFile(...) for changes, used by reloadIfChanged().
+		void setHotReload(bool hotReload);
+
+		bool isHotReload() const noexcept {
+			return watcher_ != nullptr;
+		}
+
+		// Recompile the program if the watched files changed, must be called on the gl thread, e.g.
+		// once per frame. The program is replaced only if the new one links, else the old one is kept
+		// and the errors are logged. Return true if replaced, i.e. the uniform locations must be
+		// looked up again and the uniforms set again.
+		bool reloadIfChanged();
+
 		// Return if the shader program is linked.
 		bool isLinked() const noexcept {
-			return programObjectId_ != 0;
+			return programObjectId_ != 0 && !pending_;
 		}
 
 	private:
 		bool linkProgram();
 
+		bool loadBinary(const std::string& file);
+
+		void saveBinary(const std::string& file) const;
+
+		std::uint64_t hashProgram(const std::string& vShader, const std::string& gShader, const std::string& fShader) const;
+
 		void bindAllAttributes();
 
-		std::map<std::string, gl::GLuint> attributes_;
-		mutable std::map<std::string, gl::GLuint> uniforms_;
+		void deleteShaders();
+
+		std::map<std::string, gl::GLuint, std::less<>> attributes_;
+		ShaderReflection reflection_;
 		
+		std::vector<gl::GLuint> shaders_;
+		std::string cacheFile_;
+		std::string vShaderFile_;
+		std::string gShaderFile_;
+		std::string fShaderFile_;
+		std::unique_ptr<FileWatcher> watcher_;
 		gl::GLuint programObjectId_ = 0;
+		bool pending_ = false;
 	};
 
 }
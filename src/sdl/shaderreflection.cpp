@@ -0,0 +1,138 @@
+#include "shaderreflection.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+namespace sdl {
+
+	namespace {
+
+		constexpr std::string_view ArraySuffix{"[0]"};
+
+		// The element locations are only looked up if GetElementLocation is not nullptr_t, e.g. for uniforms.
+		template <typename GetActive, typename GetElementLocation = std::nullptr_t>
+		void reflectVariables(ShaderVariableTable& table, gl::GLuint program, gl::GLenum count, gl::GLenum maxLength, GetActive&& getActive,
+			GetElementLocation&& getElementLocation = nullptr) {
+
+			gl::GLint size = 0;
+			gl::glGetProgramiv(program, count, &size);
+			gl::GLint length = 0;
+			gl::glGetProgramiv(program, maxLength, &length);
+			std::string name(static_cast<std::size_t>(std::max(length, 1)), '\0');
+
+			for (gl::GLint i = 0; i < size; ++i) {
+				gl::GLsizei nameLength = 0;
+				auto variable = getActive(static_cast<gl::GLuint>(i), name, nameLength);
+				variable.name.assign(name.data(), nameLength);
+
+				// Arrays are reported as "name[0]", make them available as "name" too.
+				std::string_view view = variable.name;
+				if (view.ends_with(ArraySuffix)) {
+					auto element = variable;
+					element.hash = fnv1a(element.name);
+					table.insert(std::move(element));
+					variable.name.resize(view.size() - ArraySuffix.size());
+
+					// And each element as "name[i]", the same as glGetUniformLocation.
+					if constexpr (!std::is_same_v<std::remove_cvref_t<GetElementLocation>, std::nullptr_t>) {
+						for (int i = 1; i < variable.size; ++i) {
+							auto elementName = variable.name + '[' + std::to_string(i) + ']';
+							auto hash = fnv1a(elementName);
+							auto location = getElementLocation(elementName);
+							table.insert(ShaderVariable{std::move(elementName), hash, location, variable.type, 1});
+						}
+					}
+				}
+				variable.hash = fnv1a(variable.name);
+				table.insert(std::move(variable));
+			}
+		}
+
+	}
+
+	void ShaderVariableTable::insert(ShaderVariable variable) {
+		if (find(variable.name) != nullptr) {
+			return;
+		}
+		variables_.push_back(std::move(variable));
+		if (variables_.size() * 2 > slots_.size()) {
+			rehash(std::bit_ceil(variables_.size() * 2));
+		} else {
+			auto mask = slots_.size() - 1;
+			auto slot = variables_.back().hash & mask;
+			while (slots_[slot] != -1) {
+				slot = (slot + 1) & mask;
+			}
+			slots_[slot] = static_cast<int>(variables_.size() - 1);
+		}
+	}
+
+	const ShaderVariable* ShaderVariableTable::find(ShaderName name) const noexcept {
+		if (slots_.empty()) {
+			return nullptr;
+		}
+		auto mask = slots_.size() - 1;
+		for (auto slot = name.getHash() & mask; slots_[slot] != -1; slot = (slot + 1) & mask) {
+			const auto& variable = variables_[slots_[slot]];
+			if (variable.hash == name.getHash() && variable.name == name.getName()) {
+				return &variable;
+			}
+		}
+		return nullptr;
+	}
+
+	void ShaderVariableTable::clear() noexcept {
+		variables_.clear();
+		slots_.clear();
+	}
+
+	void ShaderVariableTable::rehash(std::size_t capacity) {
+		slots_.assign(capacity, -1);
+		auto mask = capacity - 1;
+		for (int i = 0; i < static_cast<int>(variables_.size()); ++i) {
+			auto slot = variables_[i].hash & mask;
+			while (slots_[slot] != -1) {
+				slot = (slot + 1) & mask;
+			}
+			slots_[slot] = i;
+		}
+	}
+
+	void ShaderReflection::reflect(gl::GLuint program) {
+		clear();
+
+		reflectVariables(uniforms_, program, gl::GL_ACTIVE_UNIFORMS, gl::GL_ACTIVE_UNIFORM_MAX_LENGTH, [&](gl::GLuint index, std::string& name, gl::GLsizei& length) {
+			gl::GLint size = 0;
+			gl::GLenum type{};
+			gl::glGetActiveUniform(program, index, static_cast<gl::GLsizei>(name.size()), &length, &size, &type, name.data());
+			auto location = gl::glGetUniformLocation(program, name.c_str());
+			return ShaderVariable{{}, 0, location, type, size};
+		}, [&](const std::string& elementName) {
+			return gl::glGetUniformLocation(program, elementName.c_str());
+		});
+
+		reflectVariables(attributes_, program, gl::GL_ACTIVE_ATTRIBUTES, gl::GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, [&](gl::GLuint index, std::string& name, gl::GLsizei& length) {
+			gl::GLint size = 0;
+			gl::GLenum type{};
+			gl::glGetActiveAttrib(program, index, static_cast<gl::GLsizei>(name.size()), &length, &size, &type, name.data());
+			auto location = gl::glGetAttribLocation(program, name.c_str());
+			return ShaderVariable{{}, 0, location, type, size};
+		});
+
+		reflectVariables(uniformBlocks_, program, gl::GL_ACTIVE_UNIFORM_BLOCKS, gl::GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, [&](gl::GLuint index, std::string& name, gl::GLsizei& length) {
+			gl::glGetActiveUniformBlockName(program, index, static_cast<gl::GLsizei>(name.size()), &length, name.data());
+			gl::GLint dataSize = 0;
+			gl::glGetActiveUniformBlockiv(program, index, gl::GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+			return ShaderVariable{{}, 0, static_cast<int>(index), gl::GLenum{}, dataSize};
+		});
+	}
+
+	void ShaderReflection::clear() noexcept {
+		uniforms_.clear();
+		attributes_.clear();
+		uniformBlocks_.clear();
+	}
+
+}
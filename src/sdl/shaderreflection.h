@@ -0,0 +1,105 @@
+#ifndef CPPSDL2_SDL_SHADERREFLECTION_H
+#define CPPSDL2_SDL_SHADERREFLECTION_H
+
+#include "hash.h"
+#include "opengl.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sdl {
+
+	// A uniform, attribute or uniform block name with its hash. Is hashed at compile time when
+	// constant, e.g. constexpr ShaderName uMat{"uMat"}, and then looked up without allocation.
+	// Refers to the name, i.e. the name must outlive the ShaderName.
+	class ShaderName {
+	public:
+		constexpr ShaderName(const char* name) noexcept
+			: ShaderName{std::string_view{name}} {
+		}
+
+		constexpr ShaderName(std::string_view name) noexcept
+			: name_{name}
+			, hash_{fnv1a(name)} {
+		}
+
+		ShaderName(const std::string& name) noexcept
+			: ShaderName{std::string_view{name}} {
+		}
+
+		constexpr std::string_view getName() const noexcept {
+			return name_;
+		}
+
+		constexpr std::uint64_t getHash() const noexcept {
+			return hash_;
+		}
+
+	private:
+		std::string_view name_;
+		std::uint64_t hash_;
+	};
+
+	struct ShaderVariable {
+		std::string name;
+		std::uint64_t hash;
+		// Uniform or attribute location, or the uniform block index. Uniforms in a block has -1.
+		int location;
+		// E.g. GL_FLOAT_MAT4, unused for uniform blocks.
+		gl::GLenum type;
+		// Array size, or the data size in bytes for uniform blocks.
+		int size;
+	};
+
+	// Flat open addressing hash table, indexed by the name hash.
+	class ShaderVariableTable {
+	public:
+		void insert(ShaderVariable variable);
+
+		// Return null if not found.
+		const ShaderVariable* find(ShaderName name) const noexcept;
+
+		const std::vector<ShaderVariable>& getVariables() const noexcept {
+			return variables_;
+		}
+
+		void clear() noexcept;
+
+	private:
+		void rehash(std::size_t capacity);
+
+		std::vector<ShaderVariable> variables_;
+		// Index into variables_, -1 for empty slots. Size is a power of two.
+		std::vector<int> slots_;
+	};
+
+	// The active uniforms, attributes and uniform blocks of a linked program.
+	class ShaderReflection {
+	public:
+		void reflect(gl::GLuint program);
+
+		void clear() noexcept;
+
+		const ShaderVariableTable& getUniforms() const noexcept {
+			return uniforms_;
+		}
+
+		const ShaderVariableTable& getAttributes() const noexcept {
+			return attributes_;
+		}
+
+		const ShaderVariableTable& getUniformBlocks() const noexcept {
+			return uniformBlocks_;
+		}
+
+	private:
+		ShaderVariableTable uniforms_;
+		ShaderVariableTable attributes_;
+		ShaderVariableTable uniformBlocks_;
+	};
+
+}
+
+#endif
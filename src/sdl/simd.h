@@ -0,0 +1,20 @@
+#ifndef CPPSDL2_SDL_SIMD_H
+#define CPPSDL2_SDL_SIMD_H
+
+// SSE2 is part of every x86-64 cpu, otherwise the scalar code paths are used.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPPSDL2_SSE2 1
+#include <emmintrin.h>
+#else
+#define CPPSDL2_SSE2 0
+#endif
+
+// AVX2 only when the compiler targets it, e.g. -mavx2 or /arch:AVX2.
+#if defined(__AVX2__)
+#define CPPSDL2_AVX2 1
+#include <immintrin.h>
+#else
+#define CPPSDL2_AVX2 0
+#endif
+
+#endif
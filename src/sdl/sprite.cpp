@@ -1,4 +1,5 @@
 #include "sprite.h"
+#include "colorpipeline.h"
 #include "surface.h"
 #include "opengl.h"
 
@@ -12,6 +13,16 @@ namespace sdl {
 	Sprite::Sprite(const std::string& image, std::function<void()>&& filter)
 		: image_{std::make_shared<ImageVariant>()} {
 		
+		if (CompressedImage::isCompressedFile(image)) {
+			CompressedImage compressed{image};
+			textureWidth_ = compressed.getWidth();
+			textureHeight_ = compressed.getHeight();
+			rect_.w = textureWidth_;
+			rect_.h = textureHeight_;
+			*image_ = CompressedData{std::move(compressed), filter};
+			return;
+		}
+
 		Surface surface{image};
 		textureWidth_ = surface.getWidth();
 		textureHeight_ = surface.getHeight();
@@ -44,15 +55,30 @@ namespace sdl {
 		, textureWidth_{surface.getWidth()}
 		, textureHeight_{surface.getHeight()} {
 
+		if (colorpipeline::isPremultipliedAlpha()) {
+			surface.premultiplyAlpha();
+		}
 		*image_ = SurfaceData{std::move(surface), filter};
 	}
 
+	Sprite::Sprite(CompressedImage&& image, std::function<void()>&& filter)
+		: image_{std::make_shared<ImageVariant>()}
+		, rect_{0, 0, image.getWidth(), image.getHeight()}
+		, textureWidth_{image.getWidth()}
+		, textureHeight_{image.getHeight()} {
+
+		*image_ = CompressedData{std::move(image), filter};
+	}
+
 	Sprite::Sprite(Surface&& surface, const Rect& rect, std::function<void()>&& filter)
 		: image_{std::make_shared<ImageVariant>()}
 		, rect_{rect}
 		, textureWidth_{surface.getWidth()}
 		, textureHeight_{surface.getHeight()} {
 
+		if (colorpipeline::isPremultipliedAlpha()) {
+			surface.premultiplyAlpha();
+		}
 		*image_ = SurfaceData{std::move(surface), filter};
 	}
 
@@ -89,6 +115,12 @@ namespace sdl {
 			texture.texImage(std::get<SurfaceData>(*image_).surface, std::move(std::get<SurfaceData>(*image_).filter));
 			texture.bind();
 			*image_ = std::move(texture);
+		} else if (std::holds_alternative<CompressedData>(*image_)) {
+			Texture texture{};
+			texture.generate();
+			texture.texImage(std::get<CompressedData>(*image_).image, std::move(std::get<CompressedData>(*image_).filter));
+			texture.bind();
+			*image_ = std::move(texture);
 		} else {
 			std::get<Texture>(*image_).bind();
 		}
@@ -149,6 +181,8 @@ namespace sdl {
 
 		if (std::holds_alternative<SurfaceData>(*image_)) {
 			return std::get<SurfaceData>(*image_).surface.isLoaded();
+		} else if (std::holds_alternative<CompressedData>(*image_)) {
+			return std::get<CompressedData>(*image_).image.isLoaded();
 		} else {
 			return std::get<Texture>(*image_).isValid();
 		}
@@ -161,7 +195,10 @@ namespace sdl {
 	void Sprite::blit(const Surface& src, const Rect& dstRect) {
 		if (image_) {
 			if (std::holds_alternative<SurfaceData>(*image_)) {
-				std::get<SurfaceData>(*image_).surface.blitSurface(src, dstRect);
+				// Copy, the same as texSubImage, i.e. not blended with the transparent atlas.
+				std::get<SurfaceData>(*image_).surface.copySurface(src, dstRect.x, dstRect.y);
+			} else if (std::holds_alternative<CompressedData>(*image_)) {
+				spdlog::warn("[sdl::Sprite] Can't blit into a compressed image");
 			} else {
 				std::get<Texture>(*image_).texSubImage(src, dstRect);
 			}
@@ -1,6 +1,7 @@
 #ifndef CPPSDL2_SDL_SPRITE_H
 #define CPPSDL2_SDL_SPRITE_H
 
+#include "compressedimage.h"
 #include "texture.h"
 #include "surface.h"
 #include "textureview.h"
@@ -20,7 +21,7 @@ namespace sdl {
 		/// @brief Create an empty sprite.
 		Sprite() = default;
 
-		/// @brief Load an image from file.
+		/// @brief Load an image from file. KTX2 and DDS files are loaded as compressed images.
 		/// @param image filename to the image
 		/// @param filter used by OpenGL when displaying the sprite
 		explicit Sprite(const std::string& image, std::function<void()>&& filter = []() {
@@ -40,6 +41,14 @@ namespace sdl {
 			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
 		});
 
+		/// @brief Use a compressed image, uploaded with its mip levels.
+		/// @param image is the loaded compressed image
+		/// @param filter used by OpenGL when displaying the sprite
+		Sprite(CompressedImage&& image, std::function<void()>&& filter = []() {
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
+		});
+
 		/// @brief Set a texture to the sprite. The sprite represents the square of the texture,
 		/// defined by (x,y) in the lower left postion with (dx,dy) = (width,height).
 		/// @param surface is the image data the sprite contains
@@ -98,7 +107,12 @@ namespace sdl {
 			std::function<void()> filter;
 		};
 
-		using ImageVariant = std::variant<SurfaceData, Texture>;
+		struct CompressedData {
+			CompressedImage image;
+			std::function<void()> filter;
+		};
+
+		using ImageVariant = std::variant<SurfaceData, CompressedData, Texture>;
 		mutable std::shared_ptr<ImageVariant> image_;
 
 		Rect rect_{};
@@ -0,0 +1,63 @@
+#include "statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace sdl {
+
+	Statistics::Statistics(std::size_t capacity)
+		: capacity_{std::max<std::size_t>(capacity, 1)} {
+
+		samples_.reserve(capacity_);
+	}
+
+	void Statistics::add(double value) {
+		if (samples_.size() < capacity_) {
+			samples_.push_back(value);
+		} else {
+			samples_[next_] = value;
+		}
+		next_ = (next_ + 1) % capacity_;
+		++totalCount_;
+	}
+
+	void Statistics::clear() noexcept {
+		samples_.clear();
+		next_ = 0;
+		totalCount_ = 0;
+	}
+
+	double Statistics::getMin() const {
+		return samples_.empty() ? 0.0 : *std::min_element(samples_.begin(), samples_.end());
+	}
+
+	double Statistics::getMax() const {
+		return samples_.empty() ? 0.0 : *std::max_element(samples_.begin(), samples_.end());
+	}
+
+	double Statistics::getMean() const {
+		return samples_.empty() ? 0.0 : std::accumulate(samples_.begin(), samples_.end(), 0.0) / samples_.size();
+	}
+
+	double Statistics::getPercentile(double percentile) const {
+		if (samples_.empty()) {
+			return 0.0;
+		}
+		// Nearest rank.
+		auto rank = static_cast<std::size_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * samples_.size()));
+		auto index = rank > 0 ? rank - 1 : 0;
+
+		sorted_.assign(samples_.begin(), samples_.end());
+		std::nth_element(sorted_.begin(), sorted_.begin() + index, sorted_.end());
+		return sorted_[index];
+	}
+
+	double Statistics::getLast() const noexcept {
+		if (samples_.empty()) {
+			return 0.0;
+		}
+		return samples_[(next_ + capacity_ - 1) % capacity_];
+	}
+
+}
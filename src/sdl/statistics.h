@@ -0,0 +1,60 @@
+#ifndef CPPSDL2_SDL_STATISTICS_H
+#define CPPSDL2_SDL_STATISTICS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace sdl {
+
+	// Statistics over the latest samples, older samples are overwritten when the capacity is reached.
+	class Statistics {
+	public:
+		explicit Statistics(std::size_t capacity = 1024);
+
+		void add(double value);
+
+		void clear() noexcept;
+
+		// Return the number of samples stored, at most the capacity.
+		std::size_t getSize() const noexcept;
+
+		std::size_t getCapacity() const noexcept;
+
+		// Return the total number of samples added since the last clear.
+		std::size_t getTotalCount() const noexcept;
+
+		double getMin() const;
+
+		double getMax() const;
+
+		double getMean() const;
+
+		// Return the value below which the percentage of the samples falls, e.g. 99 for the 99th percentile.
+		double getPercentile(double percentile) const;
+
+		// Return the latest sample, or zero if empty.
+		double getLast() const noexcept;
+
+	private:
+		std::vector<double> samples_;
+		mutable std::vector<double> sorted_;
+		std::size_t capacity_;
+		std::size_t next_ = 0;
+		std::size_t totalCount_ = 0;
+	};
+
+	inline std::size_t Statistics::getSize() const noexcept {
+		return samples_.size();
+	}
+
+	inline std::size_t Statistics::getCapacity() const noexcept {
+		return capacity_;
+	}
+
+	inline std::size_t Statistics::getTotalCount() const noexcept {
+		return totalCount_;
+	}
+
+}
+
+#endif
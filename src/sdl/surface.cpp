@@ -1,43 +1,82 @@
 #include "surface.h"
+#include "colorpipeline.h"
+#include "colorspan.h"
+#include "pixels.h"
 #include "font.h"
+#include "opengl.h"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cassert>
-#include <tuple>
+#include <span>
 
 namespace sdl {
 
 	namespace {
 
-		using Pixel1 = std::tuple<Uint8>;
-		using Pixel2 = std::tuple<Uint8, Uint8>;
-		using Pixel3 = std::tuple<Uint8, Uint8, Uint8>;
-		using Pixel4 = std::tuple<Uint8, Uint8, Uint8, Uint8>;
-
-		template <typename Pixel>
-		void flipVerticalGeneric(SDL_Surface* surface) {
-			assert(surface != nullptr);
-			for (int i = 0; i < surface->h / 2; ++i) {
-				for (int j = 0; j < surface->w; ++j) {
-					auto startElement = static_cast<Pixel*>(surface->pixels) + i * surface->w + j;
-					auto endElement = static_cast<Pixel*>(surface->pixels) + (surface->h - i - 1) * surface->w + j;
-					std::swap(*startElement, *endElement);
-				}
+		void flipVertical(SDL_Surface* surface) {
+			assert(surface != nullptr && surface->format->BytesPerPixel >= 1 && surface->format->BytesPerPixel <= 4);
+			SDL_LockSurface(surface);
+			pixels::flipVertical(surface->pixels, surface->pitch, surface->w * surface->format->BytesPerPixel, surface->h);
+			SDL_UnlockSurface(surface);
+		}
+
+		// Return a RGBA32 copy of the surface, or null if the format is not supported by the fast paths.
+		SDL_Surface* fastConvertToRgba32(SDL_Surface* surface) {
+			const auto format = surface->format->format;
+			if (format != SDL_PIXELFORMAT_RGB24 && format != SDL_PIXELFORMAT_BGRA32) {
+				return nullptr;
+			}
+			auto rgba = SDL_CreateRGBSurfaceWithFormat(0, surface->w, surface->h, 32, SDL_PIXELFORMAT_RGBA32);
+			if (rgba == nullptr) {
+				return nullptr;
+			}
+			SDL_LockSurface(surface);
+			if (format == SDL_PIXELFORMAT_RGB24) {
+				pixels::rgbToRgba(surface->pixels, surface->pitch, rgba->pixels, rgba->pitch, surface->w, surface->h);
+			} else {
+				pixels::bgraToRgba(surface->pixels, surface->pitch, rgba->pixels, rgba->pitch, surface->w, surface->h);
 			}
+			SDL_UnlockSurface(surface);
+			return rgba;
 		}
 
-		void flipVertical(SDL_Surface* surface) {
-			assert(surface != nullptr && surface->format->BytesPerPixel >= 1 && surface->format->BytesPerPixel <= 4);
-			if (surface->format->BytesPerPixel == 4) {
-				flipVerticalGeneric<Pixel4>(surface);
-			} else if (surface->format->BytesPerPixel == 3) {
-				flipVerticalGeneric<Pixel3>(surface);
-			} else if (surface->format->BytesPerPixel == 2) {
-				flipVerticalGeneric<Pixel2>(surface);
-			} else if (surface->format->BytesPerPixel == 1) {
-				flipVerticalGeneric<Pixel1>(surface);
+		// Copy without blending, clipped to the destination. Both surfaces must have the same format.
+		void copyClipped(SDL_Surface* src, SDL_Surface* dst, int x, int y) {
+			assert(src->format->format == dst->format->format);
+			const int x0 = std::max(x, 0);
+			const int y0 = std::max(y, 0);
+			const int x1 = std::min(x + src->w, dst->w);
+			const int y1 = std::min(y + src->h, dst->h);
+			if (x0 >= x1 || y0 >= y1) {
+				return;
 			}
+			const int bytesPerPixel = dst->format->BytesPerPixel;
+			SDL_LockSurface(src);
+			SDL_LockSurface(dst);
+			pixels::copy(static_cast<const Uint8*>(src->pixels) + (y0 - y) * src->pitch + (x0 - x) * bytesPerPixel, src->pitch,
+				static_cast<Uint8*>(dst->pixels) + y0 * dst->pitch + x0 * bytesPerPixel, dst->pitch,
+				(x1 - x0) * bytesPerPixel, y1 - y0);
+			SDL_UnlockSurface(dst);
+			SDL_UnlockSurface(src);
+		}
+
+		// The surface must be RGBA32, i.e. the same memory layout as Color.
+		void premultiplySurfaceAlpha(SDL_Surface* surface, bool additive) {
+			assert(surface != nullptr && surface->format->format == SDL_PIXELFORMAT_RGBA32);
+			SDL_LockSurface(surface);
+			for (int y = 0; y < surface->h; ++y) {
+				auto row = reinterpret_cast<Color*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+				std::span<Color> colors{row, static_cast<std::size_t>(surface->w)};
+				color::premultiplyAlpha(colors);
+				if (additive) {
+					for (auto& color : colors) {
+						color = Color::createU32(color.redByte(), color.greenByte(), color.blueByte(), 0);
+					}
+				}
+			}
+			SDL_UnlockSurface(surface);
 		}
 
 		SDL_Surface* createSurface(int w, int h) {
@@ -68,7 +107,13 @@ namespace sdl {
 		SDL_Surface* createSurface(const std::string& text, TTF_Font* font, Color color) {
 			if (font != nullptr) {
 				SDL_Surface* argb = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-				SDL_Surface* rgba = SDL_ConvertSurfaceFormat(argb, SDL_PIXELFORMAT_RGBA32, 0);
+				if (argb == nullptr) {
+					return nullptr;
+				}
+				SDL_Surface* rgba = fastConvertToRgba32(argb);
+				if (rgba == nullptr) {
+					rgba = SDL_ConvertSurfaceFormat(argb, SDL_PIXELFORMAT_RGBA32, 0);
+				}
 				SDL_FreeSurface(argb);
 				return rgba;
 			}
@@ -86,22 +131,32 @@ namespace sdl {
 	Surface::Surface(int w, int h) {
 		assert(w > 0 && h > 0);
 		surface_ = createSurface(w, h);
+		// Transparent, i.e. the same premultiplied or not.
+		premultipliedAlpha_ = surface_ != nullptr && colorpipeline::isPremultipliedAlpha();
 	}
 
 	Surface::Surface(const std::string& filename) {
 		surface_ = IMG_Load(filename.c_str());
 		if (surface_ == nullptr) {
 			spdlog::warn("[sdl::Surface] Image {} failed to be loaded: {}", filename, IMG_GetError());
+		} else if (colorpipeline::isPremultipliedAlpha()) {
+			premultiplyAlpha();
 		}
 	}
 
 	Surface::Surface(int w, int h, Color color) {
 		assert(w > 0 && h > 0);
 		surface_ = createSurface(w, h, color);
+		if (surface_ != nullptr && colorpipeline::isPremultipliedAlpha()) {
+			premultiplyAlpha();
+		}
 	}
 
 	Surface::Surface(const std::string& text, const Font& font, Color color) {
 		surface_ = createSurface(text, font.font_, color);
+		if (surface_ != nullptr && colorpipeline::isPremultipliedAlpha()) {
+			premultiplyAlpha();
+		}
 	}
 
 	Surface::~Surface() {
@@ -110,13 +165,15 @@ namespace sdl {
 	}
 
 	Surface::Surface(Surface&& other) noexcept
-		: surface_{std::exchange(other.surface_, nullptr)} {
+		: surface_{std::exchange(other.surface_, nullptr)}
+		, premultipliedAlpha_{std::exchange(other.premultipliedAlpha_, false)} {
 	}
 
 	Surface& Surface::operator=(Surface&& other) noexcept {
 		// Safe to pass null.
 		SDL_FreeSurface(surface_);
 		surface_ = std::exchange(other.surface_, nullptr);
+		premultipliedAlpha_ = std::exchange(other.premultipliedAlpha_, false);
 		return *this;
 	}
 
@@ -146,6 +203,11 @@ namespace sdl {
 	}
 
 	void Surface::blitSurface(const Surface& src, const Rect& rect) {
+		if (premultipliedAlpha_ || src.premultipliedAlpha_) {
+			// SDL blends with straight alpha.
+			copySurface(src, rect.x, rect.y);
+			return;
+		}
 		auto newSurface = SDL_ConvertSurface(src.surface_, surface_->format, 0);
 		if (newSurface == nullptr) {
 			spdlog::warn("[sdl::Surface] Failed to blit surface, during convert: {}", SDL_GetError());
@@ -155,6 +217,85 @@ namespace sdl {
 		if (SDL_BlitSurface(newSurface, 0, surface_, &sdlRect) != 0) {
 			spdlog::warn("[sdl::Surface] Failed to blit surface: {}", SDL_GetError());
 		}
+		SDL_FreeSurface(newSurface);
 	}
-	
+
+	void Surface::copySurface(const Surface& src, int x, int y) {
+		if (surface_ == nullptr || src.surface_ == nullptr) {
+			return;
+		}
+		if (src.surface_->format->format == surface_->format->format && src.premultipliedAlpha_ == premultipliedAlpha_) {
+			copyClipped(src.surface_, surface_, x, y);
+			return;
+		}
+		auto newSurface = SDL_ConvertSurface(src.surface_, surface_->format, 0);
+		if (newSurface == nullptr) {
+			spdlog::warn("[sdl::Surface] Failed to copy surface, during convert: {}", SDL_GetError());
+			return;
+		}
+		if (premultipliedAlpha_ && !src.premultipliedAlpha_ && newSurface->format->format == SDL_PIXELFORMAT_RGBA32) {
+			premultiplySurfaceAlpha(newSurface, false);
+		}
+		copyClipped(newSurface, surface_, x, y);
+		SDL_FreeSurface(newSurface);
+	}
+
+	bool Surface::convertToRgba32() {
+		if (surface_ == nullptr) {
+			return false;
+		}
+		if (surface_->format->format == SDL_PIXELFORMAT_RGBA32) {
+			return true;
+		}
+		auto rgba = fastConvertToRgba32(surface_);
+		if (rgba == nullptr) {
+			rgba = SDL_ConvertSurfaceFormat(surface_, SDL_PIXELFORMAT_RGBA32, 0);
+		}
+		if (rgba == nullptr) {
+			spdlog::warn("[sdl::Surface] Failed to convert to RGBA32: {}", SDL_GetError());
+			return false;
+		}
+		SDL_FreeSurface(surface_);
+		surface_ = rgba;
+		return true;
+	}
+
+	void Surface::premultiplyAlpha(bool additive) {
+		if (surface_ == nullptr || premultipliedAlpha_) {
+			return;
+		}
+		if (!convertToRgba32()) {
+			return;
+		}
+		premultiplySurfaceAlpha(surface_, additive);
+		premultipliedAlpha_ = true;
+	}
+
+	bool Surface::savePng(const std::string& filename) const {
+		if (surface_ == nullptr) {
+			spdlog::warn("[sdl::Surface] Failed to save {}, surface not loaded", filename);
+			return false;
+		}
+		if (IMG_SavePNG(surface_, filename.c_str()) != 0) {
+			spdlog::warn("[sdl::Surface] Failed to save {}: {}", filename, IMG_GetError());
+			return false;
+		}
+		return true;
+	}
+
+	Surface Surface::readFrameBuffer(int width, int height) {
+		Surface surface{width, height};
+		if (surface.surface_ == nullptr) {
+			return surface;
+		}
+		gl::GLint packAlignment = 4;
+		gl::glGetIntegerv(gl::GL_PACK_ALIGNMENT, &packAlignment);
+		gl::glPixelStorei(gl::GL_PACK_ALIGNMENT, 4);
+		gl::glReadPixels(0, 0, width, height, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, surface.surface_->pixels);
+		gl::glPixelStorei(gl::GL_PACK_ALIGNMENT, packAlignment);
+		// OpenGL stores the first row at the bottom.
+		flipVertical(surface.surface_);
+		return surface;
+	}
+
 }
@@ -43,14 +43,39 @@ namespace sdl {
 
 		int getHeight() const noexcept;
 
+		// Copy the source into the rect. Premultiplied surfaces are copied without blending.
 		void blitSurface(const Surface& src, const Rect& rect);
 
+		// Copy the source to (x, y) without blending, clipped to the surface. Rows are copied
+		// directly if the formats are the same.
+		void copySurface(const Surface& src, int x, int y);
+
+		// Convert to RGBA32, with fast paths for RGB24 and BGRA32. Return false on failure.
+		bool convertToRgba32();
+
+		// Multiply the color channels with alpha, converts the surface to RGBA32 if needed.
+		// Additive sets alpha to zero afterwards, i.e. drawn with additive blending by the
+		// premultiplied color pipeline. Does nothing if already premultiplied.
+		void premultiplyAlpha(bool additive = false);
+
+		bool isPremultipliedAlpha() const noexcept {
+			return premultipliedAlpha_;
+		}
+
+		// Save the surface as a PNG file, return true on success.
+		bool savePng(const std::string& filename) const;
+
+		// Read the RGBA pixels of the binded frame buffer, with the first row at the top.
+		static Surface readFrameBuffer(int width, int height);
+
 	private:
+		friend class CompressedImage;
 		friend class Texture;
 		friend class TextureAtlas;
 		friend void flipVertical(Surface& surface);
 
 		SDL_Surface* surface_ = nullptr;
+		bool premultipliedAlpha_ = false;
 	};
 
 }
@@ -1,33 +1,79 @@
 #include "texture.h"
 #include "surface.h"
 #include "opengl.h"
+#include "glstate.h"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <bit>
+
 namespace sdl {
 
+	namespace {
+
+		bool isTexStorageSupported() {
+			static const bool supported = isVersionSupported(4, 2) || isExtensionSupported("GL_ARB_texture_storage");
+			return supported;
+		}
+
+	}
+
+	float getMaxAnisotropy() {
+		static const float maxAnisotropy = []() {
+			if (!isVersionSupported(4, 6) && !isExtensionSupported("GL_EXT_texture_filter_anisotropic")
+				&& !isExtensionSupported("GL_ARB_texture_filter_anisotropic")) {
+				return 1.f;
+			}
+			gl::GLfloat value = 1.f;
+			// The same enum value as GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT.
+			gl::glGetFloatv(gl::GL_MAX_TEXTURE_MAX_ANISOTROPY, &value);
+			return std::max(value, 1.f);
+		}();
+		return maxAnisotropy;
+	}
+
+	std::function<void()> mipmapFilter(float anisotropy) {
+		return [anisotropy]() {
+			Texture::useMipmaps();
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR_MIPMAP_LINEAR);
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
+			if (auto maxAnisotropy = getMaxAnisotropy(); maxAnisotropy > 1.f) {
+				gl::glTexParameterf(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAX_ANISOTROPY, std::clamp(anisotropy, 1.f, maxAnisotropy));
+			}
+		};
+	}
+
 	Texture::~Texture() {
 		if (texture_ != 0) {
+			glstate::forgetTexture(texture_);
 			gl::glDeleteTextures(1, &texture_);
 		}
 	}
 
 	Texture::Texture(Texture&& texture) noexcept
-		: texture_{std::exchange(texture.texture_, 0)} {
+		: texture_{std::exchange(texture.texture_, 0)}
+		, size_{std::exchange(texture.size_, {})}
+		, levels_{std::exchange(texture.levels_, 0)}
+		, immutable_{std::exchange(texture.immutable_, false)} {
 
 	}
 
 	Texture& Texture::operator=(Texture&& texture) noexcept {
 		if (texture_ != 0) {
+			glstate::forgetTexture(texture_);
 			gl::glDeleteTextures(1, &texture_);
 		}
 		texture_ = std::exchange(texture.texture_, 0);
+		size_ = std::exchange(texture.size_, {});
+		levels_ = std::exchange(texture.levels_, 0);
+		immutable_ = std::exchange(texture.immutable_, false);
 		return *this;
 	}
 
 	void Texture::bind() {
 		if (texture_ != 0) {
-			gl::glBindTexture(gl::GL_TEXTURE_2D, texture_);
+			glstate::bindTexture(texture_);
 		} else {
 			spdlog::debug("[sdl::Texture] Must be generated first");
 		}
@@ -35,18 +81,136 @@ namespace sdl {
 
 	void Texture::texSubImage(const Surface& surface, const Rect& dst) {
 		if (isValid() && surface.isLoaded()) {
-			gl::glBindTexture(gl::GL_TEXTURE_2D, texture_);
+			glstate::bindTexture(texture_);
 			glTexSubImage2D(gl::GL_TEXTURE_2D, 0,
 				dst.x, dst.y,
 				dst.w, dst.h,
 				surfaceFormat(surface.surface_),
 				gl::GL_UNSIGNED_BYTE,
 				surface.surface_->pixels);
+			// Regenerated directly, the texture is also binded as a raw id by Graphic and TextureView.
+			if (levels_ > 1) {
+				gl::glGenerateMipmap(gl::GL_TEXTURE_2D);
+			}
 		} else {
 			spdlog::warn("[sdl::Texture] texSubImage failed");
 		}
 	}
 
+	void Texture::texStorage(int width, int height, int levels) {
+		if (!isValid()) {
+			spdlog::debug("[sdl::Texture] Failed to allocate, must be generated first");
+			return;
+		}
+		if (immutable_) {
+			spdlog::warn("[sdl::Texture] Immutable storage already allocated");
+			return;
+		}
+
+		glstate::bindTexture(texture_);
+		if (!isTexStorageSupported()) {
+			allocateLevels(width, height, levels, gl::GL_RGBA);
+			return;
+		}
+		levels = std::clamp(levels, 1, getMipLevelCount(width, height));
+		gl::glTexStorage2D(gl::GL_TEXTURE_2D, levels, colorpipeline::getInternalFormat(gl::GL_RGBA8), width, height);
+		immutable_ = true;
+		size_ = {width, height};
+		levels_ = levels;
+	}
+
+	void Texture::generateMipmap() {
+		if (isValid()) {
+			glstate::bindTexture(texture_);
+			gl::glGenerateMipmap(gl::GL_TEXTURE_2D);
+		} else {
+			spdlog::debug("[sdl::Texture] Must be generated first");
+		}
+	}
+
+	int Texture::getMipLevelCount(int width, int height) {
+		return std::bit_width(static_cast<unsigned int>(std::max({width, height, 1})));
+	}
+
+	bool Texture::allocate(int width, int height, gl::GLenum format, bool mipmaps) {
+		if (immutable_) {
+			if (size_.width != width || size_.height != height) {
+				spdlog::warn("[sdl::Texture] Immutable storage {}x{} can't be reallocated to {}x{}", size_.width, size_.height, width, height);
+				return false;
+			}
+			return true;
+		}
+		allocateLevels(width, height, mipmaps ? getMipLevelCount(width, height) : 1, format);
+		return true;
+	}
+
+	void Texture::allocateLevels(int width, int height, int levels, gl::GLenum format) {
+		levels = std::clamp(levels, 1, getMipLevelCount(width, height));
+		const auto internalFormat = colorpipeline::getInternalFormat(format);
+		for (int level = 0; level < levels; ++level) {
+			gl::glTexImage2D(gl::GL_TEXTURE_2D, level, internalFormat,
+				std::max(width >> level, 1), std::max(height >> level, 1),
+				0,
+				format,
+				gl::GL_UNSIGNED_BYTE,
+				nullptr
+			);
+		}
+		gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAX_LEVEL, levels - 1);
+		size_ = {width, height};
+		levels_ = levels;
+	}
+
+	void Texture::uploadCompressed(const CompressedImage& image) {
+		if (immutable_) {
+			spdlog::warn("[sdl::Texture] Compressed image can't be uploaded to immutable storage");
+			return;
+		}
+
+		// Color data is sRGB in the linear pipeline, the same as uncompressed textures.
+		const auto format = colorpipeline::getInternalFormat(image.getFormat());
+		const auto levels = image.getLevelCount();
+		size_ = image.getSize();
+		levels_ = levels;
+		gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_BASE_LEVEL, 0);
+		gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+		if (image.isFormatSupported()) {
+			for (int i = 0; i < levels; ++i) {
+				const auto& level = image.getLevel(i);
+				const auto data = image.getLevelData(i);
+				gl::glCompressedTexImage2D(gl::GL_TEXTURE_2D, i, format,
+					level.width, level.height,
+					0,
+					static_cast<gl::GLsizei>(data.size()),
+					data.data()
+				);
+			}
+			return;
+		}
+
+		if (!image.isDecodable()) {
+			spdlog::warn("[sdl::Texture] Compressed format {:#x} is neither supported nor decodable", static_cast<unsigned int>(image.getFormat()));
+			return;
+		}
+
+		spdlog::info("[sdl::Texture] Compressed format {:#x} not supported, decoding on the CPU", static_cast<unsigned int>(image.getFormat()));
+		const auto internalFormat = image.isSrgb() || format != image.getFormat() ? gl::GL_SRGB8_ALPHA8 : gl::GL_RGBA8;
+		for (int i = 0; i < levels; ++i) {
+			auto surface = image.decode(i);
+			if (!surface.isLoaded()) {
+				return;
+			}
+			gl::glTexImage2D(gl::GL_TEXTURE_2D, i, internalFormat,
+				surface.surface_->w, surface.surface_->h,
+				0,
+				gl::GL_RGBA,
+				gl::GL_UNSIGNED_BYTE,
+				surface.surface_->pixels
+			);
+		}
+	}
+
 	void Texture::generate() {
 		if (texture_ == 0) {
 			gl::glGenTextures(1, &texture_);
@@ -1,16 +1,29 @@
 #ifndef CPPSDL2_SDL_TEXTURE_H
 #define CPPSDL2_SDL_TEXTURE_H
 
+#include "colorpipeline.h"
+#include "compressedimage.h"
 #include "opengl.h"
+#include "glstate.h"
 #include "rect.h"
 #include "surface.h"
 
 #include <spdlog/spdlog.h>
 
+#include <functional>
 #include <type_traits>
+#include <utility>
 
 namespace sdl {
 
+	// Return the max anisotropy supported, 1 if anisotropic filtering is not supported.
+	float getMaxAnisotropy();
+
+	// Return a filter with trilinear filtering, i.e. mipmaps are generated when the texture is uploaded.
+	// Calls Texture::useMipmaps().
+	// The anisotropy is clamped to getMaxAnisotropy(), e.g. use 16 for the best quality.
+	std::function<void()> mipmapFilter(float anisotropy = 1.f);
+
 	class Texture {
 	public:
 		friend class TextureAtlas;
@@ -30,8 +43,42 @@ namespace sdl {
 
 		void texImage(const Surface& surface, std::invocable auto&& filter);
 
+		// Update level 0 of the texture. If the texture has more levels, the mipmaps are regenerated.
 		void texSubImage(const Surface& surface, const Rect& dst);
 
+		// Upload the compressed image with all its mip levels. Formats not supported by
+		// the driver are decoded on the CPU if possible, i.e. BC1-BC5.
+		void texImage(const CompressedImage& image);
+
+		void texImage(const CompressedImage& image, std::invocable auto&& filter);
+
+		// Allocate an empty RGBA texture, e.g. to be rendered to by a FrameBuffer.
+		// Is sRGB if the color pipeline is linear.
+		void texImage(int width, int height);
+
+		void texImage(int width, int height, std::invocable auto&& filter);
+
+		// Allocate immutable RGBA storage, uses glTexStorage2D if supported (OpenGL 4.2).
+		// Can't be reallocated with another size, only updated. texImage allocates mutable
+		// storage unless this is called first.
+		void texStorage(int width, int height, int levels = 1);
+
+		// Generate all mip levels from level 0.
+		void generateMipmap();
+
+		int getLevelCount() const noexcept {
+			return levels_;
+		}
+
+		// Return the number of levels of a full mip chain, i.e. down to 1x1.
+		static int getMipLevelCount(int width, int height);
+
+		// Call from a filter which sets a mipmap min filter, for texImage to allocate and generate
+		// the mip chain. The filter state is not read back from OpenGL.
+		static void useMipmaps() noexcept {
+			mipmapsRequested_ = true;
+		}
+
 		void generate();
 		
 		bool isValid() const noexcept;
@@ -47,9 +94,32 @@ namespace sdl {
 	private:
 		static gl::GLenum surfaceFormat(SDL_Surface* surface);
 
+		void uploadCompressed(const CompressedImage& image);
+
+		// Call the filter, return true if it called useMipmaps().
+		static bool applyFilter(std::invocable auto&& filter);
+
+		// Allocate mutable storage, with a full mip chain if mipmaps are used.
+		// Return false if the texture is immutable with another size.
+		bool allocate(int width, int height, gl::GLenum format, bool mipmaps);
+
+		// Allocate each level with glTexImage2D, i.e. mutable storage.
+		void allocateLevels(int width, int height, int levels, gl::GLenum format);
+
+		static inline thread_local bool mipmapsRequested_ = false;
+
 		gl::GLuint texture_{};
+		Size size_{};
+		int levels_ = 0;
+		bool immutable_ = false;
 	};
 
+	bool Texture::applyFilter(std::invocable auto&& filter) {
+		mipmapsRequested_ = false;
+		filter();
+		return std::exchange(mipmapsRequested_, false);
+	}
+
 	inline bool operator==(const Texture& left, const Texture& right) noexcept {
 		return left.texture_ == right.texture_;
 	}
@@ -65,6 +135,60 @@ namespace sdl {
 		});
 	}
 
+	inline void Texture::texImage(const CompressedImage& image) {
+		texImage(image, []() {
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
+		});
+	}
+
+	inline void Texture::texImage(int width, int height) {
+		texImage(width, height, []() {
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_S, gl::GL_CLAMP_TO_EDGE);
+			gl::glTexParameteri(gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_T, gl::GL_CLAMP_TO_EDGE);
+		});
+	}
+
+	void Texture::texImage(int width, int height, std::invocable auto&& filter) {
+		if (!isValid()) {
+			spdlog::debug("[sdl::Texture] Failed to bind, must be generated first");
+			return;
+		}
+
+		glstate::bindTexture(texture_);
+		if (bool mipmaps = applyFilter(filter); immutable_ || mipmaps) {
+			allocate(width, height, gl::GL_RGBA, mipmaps);
+			return;
+		}
+		gl::glTexImage2D(gl::GL_TEXTURE_2D, 0, colorpipeline::getInternalFormat(gl::GL_RGBA8),
+			width, height,
+			0,
+			gl::GL_RGBA,
+			gl::GL_UNSIGNED_BYTE,
+			nullptr
+		);
+		size_ = {width, height};
+		levels_ = 1;
+	}
+
+	void Texture::texImage(const CompressedImage& image, std::invocable auto&& filter) {
+		if (!image.isLoaded()) {
+			spdlog::debug("[sdl::Texture] Failed to bind, must be loaded first");
+			return;
+		}
+
+		if (!isValid()) {
+			spdlog::debug("[sdl::Texture] Failed to bind, must be generated first");
+			return;
+		}
+
+		glstate::bindTexture(texture_);
+		filter();
+		uploadCompressed(image);
+	}
+
 	void Texture::texImage(const Surface& surface, std::invocable auto&& filter) {
 		if (!surface.isLoaded()) {
 			spdlog::debug("[sdl::Texture] Failed to bind, must be loaded first");
@@ -82,15 +206,22 @@ namespace sdl {
 			return;
 		}
 
-		gl::glBindTexture(gl::GL_TEXTURE_2D, texture_);
-		filter();
-		gl::glTexImage2D(gl::GL_TEXTURE_2D, 0, format,
+		glstate::bindTexture(texture_);
+		if (bool mipmaps = applyFilter(filter); immutable_ || mipmaps) {
+			if (allocate(surface.surface_->w, surface.surface_->h, format, mipmaps)) {
+				texSubImage(surface, {0, 0, surface.surface_->w, surface.surface_->h});
+			}
+			return;
+		}
+		gl::glTexImage2D(gl::GL_TEXTURE_2D, 0, colorpipeline::getInternalFormat(format),
 			surface.surface_->w, surface.surface_->h,
 			0,
 			format,
 			gl::GL_UNSIGNED_BYTE,
 			surface.surface_->pixels
 		);
+		size_ = {surface.surface_->w, surface.surface_->h};
+		levels_ = 1;
 	}
 
 }
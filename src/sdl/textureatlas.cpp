@@ -1,4 +1,5 @@
 #include "textureatlas.h"
+#include "pixels.h"
 
 #include <spdlog/spdlog.h>
 
@@ -17,6 +18,16 @@ namespace sdl {
 		return root->insert(surface, border);
 	}
 
+	Surface TextureAtlas::createExtruded(const Surface& surface, int border) {
+		Surface extruded{surface.getWidth() + 2 * border, surface.getHeight() + 2 * border};
+		extruded.copySurface(surface, border, border);
+		auto s = extruded.surface_;
+		SDL_LockSurface(s);
+		pixels::extrude(s->pixels, s->pitch, s->format->BytesPerPixel, s->w, s->h, border);
+		SDL_UnlockSurface(s);
+		return extruded;
+	}
+
 	TextureAtlas::Node::Node(Rect rect)
 		: rect_{rect} {
 	}
@@ -76,7 +87,8 @@ namespace sdl {
 		std::string key = filename + uniqueKey;
 		auto it = images_.find(key);
 		if (it == images_.end()) {
-			Surface surface{filename};
+			// The atlas is uncompressed, i.e. compressed files are decoded.
+			Surface surface = CompressedImage::isCompressedFile(filename) ? CompressedImage{filename}.decode() : Surface{filename};
 			if (surface.isLoaded()) {
 				return add(std::move(surface), border, key);
 			} else {
@@ -102,11 +114,15 @@ namespace sdl {
 				if (node) {
 					// Only when atlas is not full.
 					Rect rect = node->getRect();
+					if (border > 0) {
+						sprite_.blit(createExtruded(surface, border), rect);
+					} else {
+						sprite_.blit(surface, rect);
+					}
 					rect.w -= 2 * border;
 					rect.h -= 2 * border;
 					rect.x += border;
 					rect.y += border;
-					sprite_.blit(surface, rect);
 					return images_[key] = Sprite{sprite_, rect};
 				} else {
 					spdlog::warn("[sdl::TextureAtlas] Not enough image space to insert image");
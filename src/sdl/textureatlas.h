@@ -29,6 +29,8 @@ namespace sdl {
 		TextureAtlas(TextureAtlas&&) = default;
 		TextureAtlas& operator=(TextureAtlas&&) = default;
 
+		// The border is filled with the edge pixels of the image, i.e. use at least 1 with
+		// linear filtering and more with mipmaps to avoid bleeding between images.
 		const Sprite& add(const std::string& filename, int border = 0, const std::string& uniqueKey = "");
 		
 		const Sprite& add(const Surface& texture, int border = 0, const std::string& uniqueKey = "");
@@ -74,6 +76,9 @@ namespace sdl {
 		static Node* createRoot(std::unique_ptr<Node>& root,
 			int width, int height, const Surface& surface, int border);
 
+		// Return a copy with the edge pixels repeated into the border, i.e. no bleeding when filtered.
+		static Surface createExtruded(const Surface& surface, int border);
+
 		Sprite sprite_;
 		mutable std::unordered_map<std::string, Sprite> images_;
 		std::unique_ptr<Node> root_;
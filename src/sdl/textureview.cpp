@@ -1,4 +1,5 @@
 #include "textureview.h"
+#include "glstate.h"
 
 namespace sdl {
 	
@@ -31,7 +32,7 @@ namespace sdl {
 	}
 
 	void TextureView::bind() {
-		gl::glBindTexture(gl::GL_TEXTURE_2D, texture_);
+		glstate::bindTexture(texture_);
 	}
 
 }
@@ -49,6 +49,12 @@ namespace sdl {
 			return size_;
 		}
 
+		// Return the view with the texture coordinates flipped vertically, e.g. to draw a texture
+		// with the first row at the bottom without flipping the pixels before the upload.
+		TextureView flipVertical() const noexcept {
+			return {*this, pos_.x, pos_.y + size_.y, size_.x, -size_.y};
+		}
+
 		void bind();
 
 		constexpr operator gl::GLuint() const noexcept {
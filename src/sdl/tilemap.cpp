@@ -0,0 +1,209 @@
+#include "tilemap.h"
+#include "graphic.h"
+#include "glstate.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sdl {
+
+	namespace {
+
+		constexpr float Sqrt3 = 1.7320508f;
+
+		void addHexagonTile(BatchIndexed<Vertex>& batch, const glm::vec2& center, float radius, const TextureView& texture, Color color) {
+			batch.startAdding();
+
+			auto texHalfSize = texture.getSize() * 0.5f;
+			auto texMiddlePos = texture.getPosition() + texHalfSize;
+			batch.pushBack(Vertex{center, texMiddlePos, color});
+
+			auto corners = graphic::getHexagonCorners(center, radius);
+			for (int i = 0; i < 6; ++i) {
+				auto tex = texHalfSize * graphic::getHexagonCorner(i); // Textures are flipped in opengl.
+				batch.pushBack(Vertex{corners[i], texMiddlePos + glm::vec2{tex.x, -tex.y}, color});
+			}
+			for (int i = 1; i <= 6; ++i) {
+				batch.insertIndexes({0, i, (i % 6) + 1});
+			}
+		}
+
+	}
+
+	Tilemap::Tilemap(int columns, int rows, float tileSize, Layout layout, int chunkSize)
+		: columns_{std::max(columns, 0)}
+		, rows_{std::max(rows, 0)}
+		, chunkSize_{std::max(chunkSize, 1)}
+		, tileSize_{tileSize}
+		, layout_{layout} {
+
+		tiles_.resize(static_cast<std::size_t>(columns_) * rows_);
+
+		chunkColumns_ = (columns_ + chunkSize_ - 1) / chunkSize_;
+		int chunkRows = (rows_ + chunkSize_ - 1) / chunkSize_;
+		chunks_.resize(static_cast<std::size_t>(chunkColumns_) * chunkRows);
+		for (int y = 0; y < chunkRows; ++y) {
+			for (int x = 0; x < chunkColumns_; ++x) {
+				initChunkBounds(chunks_[x + y * chunkColumns_], x, y);
+			}
+		}
+	}
+
+	int Tilemap::addTile(const TextureView& textureView) {
+		if (!tileTypes_.empty() && static_cast<gl::GLuint>(textureView) != static_cast<gl::GLuint>(texture_)) {
+			spdlog::error("[sdl::Tilemap] Tile must use the same texture as the other tiles");
+			return EmptyTile;
+		}
+		texture_ = textureView;
+		tileTypes_.push_back(textureView);
+		return static_cast<int>(tileTypes_.size()) - 1;
+	}
+
+	void Tilemap::set(int column, int row, int tileId, Color color) {
+		if (!isInside(column, row)) {
+			spdlog::warn("[sdl::Tilemap] Tile ({}, {}) is outside the map", column, row);
+			return;
+		}
+		if (tileId != EmptyTile && (tileId < 0 || tileId >= static_cast<int>(tileTypes_.size()))) {
+			spdlog::warn("[sdl::Tilemap] Invalid tile id {}", tileId);
+			return;
+		}
+		auto& tile = tiles_[column + row * columns_];
+		if (tile.id != tileId || tile.color != color) {
+			tile = {tileId, color};
+			chunks_[getChunkIndex(column, row)].dirty = true;
+		}
+	}
+
+	int Tilemap::get(int column, int row) const {
+		if (!isInside(column, row)) {
+			return EmptyTile;
+		}
+		return tiles_[column + row * columns_].id;
+	}
+
+	glm::vec2 Tilemap::getTileCenter(int column, int row) const {
+		switch (layout_) {
+			case Layout::Hexagon:
+				return {1.5f * tileSize_ * column, Sqrt3 * tileSize_ * (row + 0.5f * (column & 1))};
+			case Layout::Square:
+				break;
+		}
+		return {tileSize_ * (column + 0.5f), tileSize_ * (row + 0.5f)};
+	}
+
+	void Tilemap::draw(Shader& shader, const glm::mat4& matrix, const glm::vec2& viewPos, const glm::vec2& viewSize) {
+		drawnChunks_ = 0;
+		if (chunks_.empty()) {
+			return;
+		}
+
+		shader.useProgram();
+		shader.setMatrix(matrix);
+		glstate::activeTexture(gl::GL_TEXTURE1);
+		if (texture_) {
+			shader.setTextureId(1);
+			glstate::bindTexture(texture_);
+		} else {
+			shader.setTextureId(-1);
+		}
+
+		auto viewMax = viewPos + viewSize;
+		for (int i = 0; i < static_cast<int>(chunks_.size()); ++i) {
+			auto& chunk = chunks_[i];
+			if (chunk.max.x < viewPos.x || chunk.min.x > viewMax.x || chunk.max.y < viewPos.y || chunk.min.y > viewMax.y) {
+				continue;
+			}
+			if (chunk.dirty) {
+				rebuild(shader, chunk, i % chunkColumns_, i / chunkColumns_);
+			}
+			if (chunk.batch.isEmpty()) {
+				continue;
+			}
+			chunk.vao.bind();
+			chunk.batch.draw(gl::GL_TRIANGLES);
+			++drawnChunks_;
+		}
+		VertexArrayObject::unbind();
+	}
+
+	void Tilemap::draw(Shader& shader, const glm::mat4& matrix) {
+		if (chunks_.empty()) {
+			drawnChunks_ = 0;
+			return;
+		}
+		auto& first = chunks_.front();
+		auto& last = chunks_.back();
+		draw(shader, matrix, first.min, last.max - first.min);
+	}
+
+	bool Tilemap::isInside(int column, int row) const noexcept {
+		return column >= 0 && column < columns_ && row >= 0 && row < rows_;
+	}
+
+	int Tilemap::getChunkIndex(int column, int row) const noexcept {
+		return column / chunkSize_ + (row / chunkSize_) * chunkColumns_;
+	}
+
+	void Tilemap::initChunkBounds(Chunk& chunk, int chunkColumn, int chunkRow) const {
+		int beginColumn = chunkColumn * chunkSize_;
+		int beginRow = chunkRow * chunkSize_;
+		int endColumn = std::min(beginColumn + chunkSize_, columns_) - 1;
+		int endRow = std::min(beginRow + chunkSize_, rows_) - 1;
+
+		glm::vec2 halfTile{0.5f * tileSize_, 0.5f * tileSize_};
+		auto min = getTileCenter(beginColumn, beginRow) - halfTile;
+		auto max = getTileCenter(endColumn, endRow) + halfTile;
+		if (layout_ == Layout::Hexagon) {
+			// Conservative bounds, covers the shifted odd columns, i.e. the first or last
+			// column may be half a tile away from its neighbour column in the chunk.
+			min = getTileCenter(beginColumn, beginRow) - glm::vec2{tileSize_, Sqrt3 * tileSize_};
+			max = getTileCenter(endColumn, endRow) + glm::vec2{tileSize_, Sqrt3 * tileSize_};
+		}
+		chunk.min = min;
+		chunk.max = max;
+	}
+
+	void Tilemap::rebuild(Shader& shader, Chunk& chunk, int chunkColumn, int chunkRow) {
+		// Static data can't be modified, replace the batch and its vao instead.
+		chunk.batch = BatchIndexed<Vertex>{gl::GL_STATIC_DRAW};
+		chunk.vao = VertexArrayObject{};
+		chunk.dirty = false;
+
+		int beginColumn = chunkColumn * chunkSize_;
+		int beginRow = chunkRow * chunkSize_;
+		int endColumn = std::min(beginColumn + chunkSize_, columns_);
+		int endRow = std::min(beginRow + chunkSize_, rows_);
+
+		for (int row = beginRow; row < endRow; ++row) {
+			for (int column = beginColumn; column < endColumn; ++column) {
+				const auto& tile = tiles_[column + row * columns_];
+				if (tile.id == EmptyTile) {
+					continue;
+				}
+				const auto& texture = tileTypes_[tile.id];
+				auto center = getTileCenter(column, row);
+				switch (layout_) {
+					case Layout::Square:
+						graphic::addRectangleImage(chunk.batch, center - 0.5f * glm::vec2{tileSize_, tileSize_}, {tileSize_, tileSize_}, texture, tile.color);
+						break;
+					case Layout::Hexagon:
+						addHexagonTile(chunk.batch, center, tileSize_, texture, tile.color);
+						break;
+				}
+			}
+		}
+
+		if (chunk.batch.isEmpty()) {
+			return;
+		}
+		chunk.vao.generate();
+		chunk.vao.bind();
+		chunk.batch.bind();
+		shader.setVertexAttribPointer();
+		chunk.batch.uploadToGraphicCard();
+	}
+
+}
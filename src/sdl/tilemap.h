@@ -0,0 +1,115 @@
+#ifndef CPPSDL2_SDL_TILEMAP_H
+#define CPPSDL2_SDL_TILEMAP_H
+
+#include "batch.h"
+#include "color.h"
+#include "shader.h"
+#include "textureview.h"
+#include "vertex.h"
+#include "vertexarrayobject.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+
+#include <vector>
+
+namespace sdl {
+
+	// Grid of tiles drawn from static vertex buffers, one per chunk of chunkSize x chunkSize tiles.
+	// Changing a tile only rebuilds the chunk containing the tile.
+	class Tilemap {
+	public:
+		enum class Layout {
+			// Square tiles with side tileSize, tile (0, 0) in the lower left corner.
+			Square,
+			// Flat topped hexagons with radius tileSize, odd columns are shifted up half a tile.
+			Hexagon
+		};
+
+		static constexpr int EmptyTile = -1;
+
+		Tilemap(int columns, int rows, float tileSize, Layout layout = Layout::Square, int chunkSize = 16);
+
+		Tilemap(const Tilemap&) = delete;
+		Tilemap& operator=(const Tilemap&) = delete;
+
+		Tilemap(Tilemap&&) noexcept = default;
+		Tilemap& operator=(Tilemap&&) noexcept = default;
+
+		// Return the tile id. All tiles must use the same texture, otherwise EmptyTile is returned.
+		int addTile(const TextureView& textureView);
+
+		void set(int column, int row, int tileId, Color color = color::White);
+
+		int get(int column, int row) const;
+
+		// Return the center of the tile in map coordinates.
+		glm::vec2 getTileCenter(int column, int row) const;
+
+		// Draw the chunks intersecting the view rectangle, given in map coordinates.
+		// Dirty chunks inside the view are rebuilt before drawing.
+		void draw(Shader& shader, const glm::mat4& matrix, const glm::vec2& viewPos, const glm::vec2& viewSize);
+
+		// Draw all chunks.
+		void draw(Shader& shader, const glm::mat4& matrix);
+
+		int getColumns() const noexcept;
+
+		int getRows() const noexcept;
+
+		Layout getLayout() const noexcept;
+
+		// Return the number of chunks drawn by the last call to draw().
+		int getDrawnChunks() const noexcept;
+
+	private:
+		struct Tile {
+			int id = EmptyTile;
+			Color color = color::White;
+		};
+
+		struct Chunk {
+			BatchIndexed<Vertex> batch{gl::GL_STATIC_DRAW};
+			VertexArrayObject vao;
+			glm::vec2 min{0.f, 0.f};
+			glm::vec2 max{0.f, 0.f};
+			bool dirty = true;
+		};
+
+		bool isInside(int column, int row) const noexcept;
+		int getChunkIndex(int column, int row) const noexcept;
+		void initChunkBounds(Chunk& chunk, int chunkColumn, int chunkRow) const;
+		void rebuild(Shader& shader, Chunk& chunk, int chunkColumn, int chunkRow);
+
+		std::vector<Tile> tiles_;
+		std::vector<TextureView> tileTypes_;
+		std::vector<Chunk> chunks_;
+		TextureView texture_;
+		int columns_ = 0;
+		int rows_ = 0;
+		int chunkSize_ = 16;
+		int chunkColumns_ = 0;
+		float tileSize_ = 1.f;
+		int drawnChunks_ = 0;
+		Layout layout_ = Layout::Square;
+	};
+
+	inline int Tilemap::getColumns() const noexcept {
+		return columns_;
+	}
+
+	inline int Tilemap::getRows() const noexcept {
+		return rows_;
+	}
+
+	inline Tilemap::Layout Tilemap::getLayout() const noexcept {
+		return layout_;
+	}
+
+	inline int Tilemap::getDrawnChunks() const noexcept {
+		return drawnChunks_;
+	}
+
+}
+
+#endif
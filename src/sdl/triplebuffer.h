@@ -0,0 +1,64 @@
+#ifndef CPPSDL2_SDL_TRIPLEBUFFER_H
+#define CPPSDL2_SDL_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace sdl {
+
+	// Lock free hand over of data from one producer thread to one consumer thread.
+	// The producer writes to its own buffer and publishes it, the consumer always gets
+	// the latest published buffer. Neither thread ever waits for the other.
+	//
+	// E.g. with a TripleBuffer<sdl::Graphic>, the main thread clears and fills the write
+	// buffer in update() and publishes it, the render thread calls update() and uploads
+	// the read buffer in render(). Buffers are reused, clear the write buffer before use.
+	template <typename Type>
+	class TripleBuffer {
+	public:
+		TripleBuffer() = default;
+
+		TripleBuffer(const TripleBuffer&) = delete;
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+		// Only called by the producer.
+		Type& getWriteBuffer() noexcept {
+			return buffers_[writeIndex_];
+		}
+
+		// Make the write buffer available to the consumer. Only called by the producer.
+		void publish() noexcept {
+			auto old = middle_.exchange(static_cast<std::uint8_t>(writeIndex_ | DirtyBit), std::memory_order_acq_rel);
+			writeIndex_ = old & IndexMask;
+		}
+
+		// Take the latest published buffer, return false if nothing new is published.
+		// Only called by the consumer.
+		bool update() noexcept {
+			if ((middle_.load(std::memory_order_relaxed) & DirtyBit) == 0) {
+				return false;
+			}
+			auto old = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+			readIndex_ = old & IndexMask;
+			return true;
+		}
+
+		// Only called by the consumer.
+		Type& getReadBuffer() noexcept {
+			return buffers_[readIndex_];
+		}
+
+	private:
+		static constexpr std::uint8_t IndexMask = 0b011;
+		static constexpr std::uint8_t DirtyBit = 0b100;
+
+		std::array<Type, 3> buffers_{};
+		std::atomic<std::uint8_t> middle_{1};
+		std::uint8_t writeIndex_ = 0;
+		std::uint8_t readIndex_ = 2;
+	};
+
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "vertexarrayobject.h"
 #include "vertexbufferobject.h"
+#include "glstate.h"
 
 #include "window.h"
 
@@ -9,6 +10,7 @@ namespace sdl {
 
 	VertexArrayObject::~VertexArrayObject() {
 		if (vao_ != 0) {
+			glstate::forgetVertexArray(vao_);
 			gl::glDeleteVertexArrays(1, &vao_);
 			spdlog::debug("[sdl::VertexArrayObject] Deleted vao: {}", vao_);
 		}
@@ -20,6 +22,7 @@ namespace sdl {
 	
 	VertexArrayObject& VertexArrayObject::operator=(VertexArrayObject&& other) noexcept {
 		if (vao_ != 0) {
+			glstate::forgetVertexArray(vao_);
 			gl::glDeleteVertexArrays(1, &vao_);
 			spdlog::debug("[sdl::VertexArrayObject] Deleted vao: {}", vao_);
 		}
@@ -37,14 +40,14 @@ namespace sdl {
 
 	void VertexArrayObject::bind() {
 		if (vao_ != 0) {
-			gl::glBindVertexArray(vao_);
+			glstate::bindVertexArray(vao_);
 		} else {
 			spdlog::debug("[sdl::VertexArrayObject] Must be generated first");
 		}
 	}
 
 	void VertexArrayObject::unbind() {
-		gl::glBindVertexArray(0);
+		glstate::bindVertexArray(0);
 		spdlog::debug("[sdl::VertexArrayObject] Unbind vao");
 	}
 
@@ -1,4 +1,6 @@
 #include "vertexbufferobject.h"
+#include "glstate.h"
+#include "renderstats.h"
 
 #include <spdlog/spdlog.h>
 
@@ -18,6 +20,7 @@ namespace sdl {
 
 	VertexBufferObject::~VertexBufferObject() {
 		if (vboId_ != 0) {
+			glstate::forgetBuffer(vboId_);
 			gl::glDeleteBuffers(1, &vboId_);
 		}
 	}
@@ -31,6 +34,7 @@ namespace sdl {
 
 	VertexBufferObject& VertexBufferObject::operator=(VertexBufferObject&& other) noexcept {
 		if (vboId_ != 0) {
+			glstate::forgetBuffer(vboId_);
 			gl::glDeleteBuffers(1, &vboId_);
 		}
 		vboId_ = std::exchange(other.vboId_, 0);
@@ -46,12 +50,19 @@ namespace sdl {
         size_ = size;
 		usage_ = usage;
 
+		auto& stats = renderstats::current();
+		++stats.bufferDataCalls;
+		stats.bytesUploaded += size;
+
         glBufferData(target_, size, data, usage);
 	}
 
 	void VertexBufferObject::bufferSubData(gl::GLsizeiptr offset, gl::GLsizeiptr size, const gl::GLvoid* data) {
 		if (vboId_ != 0 && target_ != 0) {
 			if (size_ > size) {
+				auto& stats = renderstats::current();
+				++stats.bufferSubDataCalls;
+				stats.bytesUploaded += size;
 				glBufferSubData(target_, offset, size, data);
 			} else {
 				bufferData(size, data, usage_);
@@ -78,14 +89,14 @@ namespace sdl {
 
 		if (vboId_ != 0) {
 			target_ = target;
-			gl::glBindBuffer(target_, vboId_);
+			glstate::bindBuffer(target_, vboId_);
 		} else {
 			spdlog::warn("[sdl::VertexBufferObject] bind failed, generate must be called first");
 		}
 	}
 
 	void VertexBufferObject::unbind() {
-		gl::glBindBuffer(target_, 0);
+		glstate::bindBuffer(target_, 0);
 	}
 
 }
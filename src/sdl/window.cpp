@@ -1,14 +1,20 @@
 #include "window.h"
 #include "exception.h"
+#include "framebuffer.h"
+#include "gldebug.h"
 #include "sprite.h"
+#include "profiler.h"
+#include "renderstats.h"
+#include "surface.h"
 
 #include <spdlog/spdlog.h>
 #include <glbinding/glbinding.h>
-#include <glbinding/FunctionCall.h>
-#include <glbinding/AbstractFunction.h>
-#include <glbinding/gl/enum.h>
 #include <SDL_image.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <thread>
 #include <chrono>
 #include <sstream>
@@ -18,30 +24,26 @@ namespace sdl {
 
 	namespace {
 
-		const char* errorString(gl::GLenum error) {
-			switch (error) {
-				case gl::GL_NO_ERROR:                          return "GL_NO_ERROR";
-				case gl::GL_INVALID_ENUM:                      return "GL_INVALID_ENUM";
-				case gl::GL_INVALID_VALUE:                     return "GL_INVALID_VALUE";
-				case gl::GL_INVALID_OPERATION:                 return "GL_INVALID_OPERATION";
-				case gl::GL_STACK_OVERFLOW:                    return "GL_STACK_OVERFLOW";
-				case gl::GL_STACK_UNDERFLOW:                   return "GL_STACK_UNDERFLOW";
-				case gl::GL_OUT_OF_MEMORY:                     return "GL_OUT_OF_MEMORY";
-				case gl::GL_INVALID_FRAMEBUFFER_OPERATION:     return "GL_INVALID_FRAMEBUFFER_OPERATION";
-				case gl::GL_TABLE_TOO_LARGE:                   return "GL_TABLE_TOO_LARGE";
+		bool isInputEvent(Uint32 type) {
+			switch (type) {
+				case SDL_KEYDOWN:
+				case SDL_KEYUP:
+				case SDL_TEXTINPUT:
+				case SDL_MOUSEMOTION:
+				case SDL_MOUSEBUTTONDOWN:
+				case SDL_MOUSEBUTTONUP:
+				case SDL_MOUSEWHEEL:
+				case SDL_CONTROLLERAXISMOTION:
+				case SDL_CONTROLLERBUTTONDOWN:
+				case SDL_CONTROLLERBUTTONUP:
+				case SDL_FINGERDOWN:
+				case SDL_FINGERUP:
+				case SDL_FINGERMOTION:
+					return true;
 			}
-			return "Unknown GL error code";
+			return false;
 		}
 
-		void enableOpengGlDebug() {
-			glbinding::setCallbackMaskExcept(glbinding::CallbackMask::After, {"glGetError"});
-			glbinding::setAfterCallback([](const glbinding::FunctionCall& call) {
-				const auto error = gl::glGetError();
-				if (error != gl::GL_NO_ERROR) {
-					spdlog::warn("{}={} {}", errorString(error), static_cast<int>(error), call.function->name());
-				}
-			});
-		}
 	}
 
 	Window::Window() {
@@ -67,9 +69,7 @@ namespace sdl {
 			throw std::exception{};
 		}
 
-		if (SDL_GL_SetSwapInterval(1) < 0) {
-			spdlog::warn("[sdl::Window] Unable to set VSync: ", SDL_GetError());
-		}
+		vsync_ = FramePacer::setSwapInterval(vsync_);
 		
 		glbinding::initialize([](const char* name) {
 			return reinterpret_cast<glbinding::ProcAddress>(SDL_GL_GetProcAddress(name));
@@ -84,7 +84,7 @@ namespace sdl {
 			throw std::exception{};
 		}
 
-		enableOpengGlDebug();
+		gldebug::setup();
 	}
 
 	Window::~Window() {
@@ -93,6 +93,7 @@ namespace sdl {
 		}
 
 		if (window_ != nullptr) {
+			latencyMonitor_.clear();
 			SDL_GL_DeleteContext(glContext_);
 			SDL_GL_UnloadLibrary();
 			SDL_DestroyWindow(window_);
@@ -107,7 +108,7 @@ namespace sdl {
 		}
 
 		spdlog::info("[sdl::Window] Init loop");
-		auto flags = SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL;
+		auto flags = (isHeadless() ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN) | SDL_WINDOW_OPENGL;
 		if (resizable_) {
 			flags |= SDL_WINDOW_RESIZABLE;
 		}
@@ -122,7 +123,7 @@ namespace sdl {
 		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, majorVersionGl_);
 		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, minorVersionGl_);
 		SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-#if _DEBUG
+#ifdef CPPSDL2_GL_DEBUG
 		SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
 #endif
 		initOpenGl();
@@ -170,26 +171,286 @@ namespace sdl {
 	}
 
 	void Window::runLoop() {
+		if (isHeadless()) {
+			runHeadlessLoop();
+			return;
+		}
+		if (renderThread_) {
+			if (isRenderThreadSupported()) {
+				runThreadedLoop();
+				return;
+			}
+			spdlog::warn("[sdl::Window] Render thread not supported by the window, uses the main thread");
+		}
+
 		spdlog::info("[sdl::Window] Loop starting");
 		auto time = Clock::now();
 		while (!quit_) {
-			gl::glClearColor(clearColor_.red(), clearColor_.green(), clearColor_.blue(), clearColor_.alpha());
-			gl::glClear(glBitfield_);
-			
-			SDL_Event eventSDL;
-			while (SDL_PollEvent(&eventSDL)) {
-				eventUpdate(eventSDL);
+			{
+				SDL_PROFILE_SCOPE("Frame");
+				gl::glClearColor(clearColor_.red(), clearColor_.green(), clearColor_.blue(), clearColor_.alpha());
+				gl::glClear(glBitfield_);
+
+				pollEventsAndUpdate(time);
+				latencyMonitor_.beginRender();
+
+				if (sleepingTime_ > std::chrono::nanoseconds{0}) {
+					std::this_thread::sleep_for(sleepingTime_);
+				}
+				framePacer_.setIdle(isIdle());
+				framePacer_.wait();
+
+				SDL_PROFILE_SCOPE("Swap");
+				SDL_GL_SwapWindow(window_);
+				latencyMonitor_.endRender();
 			}
+			SDL_PROFILE_NEW_FRAME();
+			renderstats::newFrame();
+			gldebug::newFrame();
+		}
+	}
 
-			auto currentTime = Clock::now();
-			auto delta = currentTime - time;
-			time = currentTime;
-			update(delta);
+	void Window::runHeadlessLoop() {
+		spdlog::info("[sdl::Window] Headless loop starting, {} frames", headlessFrames_);
+		auto size = getDrawableSize();
+
+		Texture color;
+		color.generate();
+		color.texImage(size.width, size.height);
+		RenderBuffer depthStencil;
+		depthStencil.generate();
+		depthStencil.storage(gl::GL_DEPTH24_STENCIL8, size.width, size.height);
+
+		FrameBuffer frameBuffer;
+		frameBuffer.generate();
+		frameBuffer.attachTexture(color);
+		frameBuffer.attachRenderBuffer(depthStencil, gl::GL_DEPTH_STENCIL_ATTACHMENT);
+		if (!frameBuffer.checkStatus()) {
+			spdlog::error("[sdl::Window] Headless frame buffer incomplete");
+			return;
+		}
+		gl::glViewport(0, 0, size.width, size.height);
 
+		headlessFrameTimes_.clear();
+		for (int frame = 0; frame < headlessFrames_ && !quit_; ++frame) {
+			auto start = Clock::now();
+			{
+				SDL_PROFILE_SCOPE("Frame");
+				gl::glClearColor(clearColor_.red(), clearColor_.green(), clearColor_.blue(), clearColor_.alpha());
+				gl::glClear(glBitfield_);
+
+				pollEventsAndUpdate(headlessFrameTime_);
+				gl::glFinish();
+			}
+			headlessFrameTimes_.add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+			if (captureInterval_ > 0 && frame % captureInterval_ == 0 && !captureFilename_.empty()) {
+				Surface::readFrameBuffer(size.width, size.height).savePng(fmt::format("{}_{:04}.png", captureFilename_, frame));
+			}
+			SDL_PROFILE_NEW_FRAME();
+			renderstats::newFrame();
+			gldebug::newFrame();
+		}
+		FrameBuffer::bindDefault();
+
+		const auto& times = headlessFrameTimes_;
+		spdlog::info("[sdl::Window] Headless loop ended, {} frames: mean {:.3f} ms, p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+			times.getTotalCount(), times.getMean(), times.getPercentile(50), times.getPercentile(99), times.getMax());
+	}
+
+	void Window::pollEventsAndUpdate(Clock::time_point& time) {
+		auto currentTime = Clock::now();
+		auto delta = currentTime - time;
+		time = currentTime;
+		pollEventsAndUpdate(delta);
+	}
+
+	void Window::pollEventsAndUpdate(const DeltaTime& deltaTime) {
+		{
+			SDL_PROFILE_SCOPE("Events");
+			pollEvents();
+			if (latencyMonitor_.isEnabled()) {
+				// Ordered by time, i.e. the first input is the oldest.
+				auto it = std::find_if(events_.begin(), events_.end(), [](const InputEvent& inputEvent) {
+					return isInputEvent(inputEvent.event.type);
+				});
+				if (it != events_.end()) {
+					latencyMonitor_.addInput(it->time);
+				}
+			}
+			eventsUpdate(events_);
+		}
+
+		{
+			SDL_PROFILE_SCOPE("Simulate");
+			simulateFixedSteps(deltaTime);
+		}
+		SDL_PROFILE_SCOPE("Update");
+		update(deltaTime);
+	}
+
+	void Window::pollEvents() {
+		events_.clear();
+		const auto pollTime = Clock::now();
+		const auto ticks = SDL_GetTicks();
+
+		SDL_Event eventSDL;
+		while (SDL_PollEvent(&eventSDL)) {
+			// SDL timestamps are milliseconds, anchored to the high resolution poll time.
+			auto age = std::chrono::milliseconds{ticks - std::min(ticks, eventSDL.common.timestamp)};
+
+			if (coalesceMouseMotion_ && eventSDL.type == SDL_MOUSEMOTION && !events_.empty()) {
+				auto& last = events_.back().event;
+				if (last.type == SDL_MOUSEMOTION && last.motion.windowID == eventSDL.motion.windowID
+					&& last.motion.which == eventSDL.motion.which && last.motion.state == eventSDL.motion.state) {
+					
+					last.motion.x = eventSDL.motion.x;
+					last.motion.y = eventSDL.motion.y;
+					last.motion.xrel += eventSDL.motion.xrel;
+					last.motion.yrel += eventSDL.motion.yrel;
+					continue;
+				}
+			}
+			events_.push_back({eventSDL, pollTime - age});
+		}
+	}
+
+	void Window::eventsUpdate(std::span<const InputEvent> events) {
+		for (const auto& inputEvent : events) {
+			eventUpdate(inputEvent.event);
+		}
+	}
+
+	void Window::runThreadedLoop() {
+		spdlog::info("[sdl::Window] Loop starting with render thread");
+		SDL_GL_MakeCurrent(window_, nullptr);
+
+		std::atomic<std::uint64_t> producedFrames{0};
+		std::atomic<std::uint64_t> renderedFrames{0};
+
+		// Written by the main thread before publishing the frame, one slot per frame in flight,
+		// i.e. the render thread never reads the slot being written.
+		struct FrameSettings {
+			Color clearColor;
+			gl::ClearBufferMask glBitfield;
+			VSync vsync;
+			int targetFps;
+			int idleFps;
+			std::chrono::nanoseconds spinTime;
+			bool idle;
+			// The oldest input reflected by the frame.
+			std::optional<LatencyMonitor::TimePoint> input;
+		};
+		std::array<FrameSettings, 2> frameSettings{};
+		const auto initialVSync = vsync_;
+		renderThreadRunning_ = true;
+
+		// Is stopped and joined when leaving the scope, also when an exception is thrown.
+		std::jthread renderThread{[&](std::stop_token stopToken) {
+			std::stop_callback wakeUp{stopToken, [&]() {
+				++producedFrames;
+				producedFrames.notify_one();
+			}};
+			if (SDL_GL_MakeCurrent(window_, glContext_) != 0) {
+				spdlog::error("[sdl::Window] Render thread failed to make the OpenGL context current: {}", SDL_GetError());
+			}
+			// Owned by the render thread, configured by the frame settings.
+			FramePacer framePacer;
+			auto vsync = initialVSync;
+			std::uint64_t frame = 0;
+			while (true) {
+				producedFrames.wait(frame);
+				if (stopToken.stop_requested()) {
+					break;
+				}
+				const auto previousFrame = std::exchange(frame, producedFrames.load());
+				const auto& settings = frameSettings[frame % 2];
+				auto input = settings.input;
+				if (frame > previousFrame + 1 && frameSettings[(frame - 1) % 2].input) {
+					// The skipped frame is not overwritten until this frame is rendered, its input is older.
+					input = frameSettings[(frame - 1) % 2].input;
+				}
+				if (settings.vsync != vsync) {
+					vsync = settings.vsync;
+					FramePacer::setSwapInterval(vsync);
+				}
+				framePacer.setTargetFps(settings.targetFps);
+				framePacer.setIdleFps(settings.idleFps);
+				framePacer.setSpinTime(settings.spinTime);
+
+				{
+					SDL_PROFILE_SCOPE("Render");
+					gl::glClearColor(settings.clearColor.red(), settings.clearColor.green(), settings.clearColor.blue(), settings.clearColor.alpha());
+					gl::glClear(settings.glBitfield);
+					latencyMonitor_.beginRender(input);
+					render();
+					framePacer.setIdle(settings.idle);
+					framePacer.wait();
+					SDL_GL_SwapWindow(window_);
+					latencyMonitor_.endRender();
+				}
+				SDL_PROFILE_NEW_FRAME();
+				renderstats::newFrame();
+				gldebug::newFrame();
+
+				renderedFrames = frame;
+				renderedFrames.notify_one();
+			}
+			SDL_GL_MakeCurrent(window_, nullptr);
+		}};
+
+		auto time = Clock::now();
+		while (!quit_) {
+			pollEventsAndUpdate(time);
+
+			frameSettings[(producedFrames.load() + 1) % 2] = {
+				clearColor_, glBitfield_, vsync_,
+				framePacer_.getTargetFps(), framePacer_.getIdleFps(), framePacer_.getSpinTime(),
+				isIdle(), latencyMonitor_.takeInput()
+			};
+			++producedFrames;
+			producedFrames.notify_one();
+
+			// At most one frame ahead of the render thread.
+			for (auto rendered = renderedFrames.load(); rendered + 1 < producedFrames; rendered = renderedFrames.load()) {
+				renderedFrames.wait(rendered);
+			}
 			if (sleepingTime_ > std::chrono::nanoseconds{0}) {
 				std::this_thread::sleep_for(sleepingTime_);
 			}
-			SDL_GL_SwapWindow(window_);
+		}
+
+		renderThread.request_stop();
+		renderThread.join();
+		renderThreadRunning_ = false;
+		SDL_GL_MakeCurrent(window_, glContext_);
+	}
+
+	bool Window::isIdle() const {
+		auto flags = SDL_GetWindowFlags(window_);
+		return (flags & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED)) != 0 || (flags & SDL_WINDOW_INPUT_FOCUS) == 0;
+	}
+
+	void Window::setVSync(VSync vsync) {
+		vsync_ = vsync;
+		if (glContext_ && !renderThreadRunning_) {
+			vsync_ = FramePacer::setSwapInterval(vsync);
+		}
+	}
+
+	void Window::simulateFixedSteps(const DeltaTime& deltaTime) {
+		if (fixedTimestep_ == DeltaTime::zero()) {
+			return;
+		}
+		accumulator_ += deltaTime;
+		for (int step = 0; step < maxSteps_ && accumulator_ >= fixedTimestep_; ++step) {
+			simulate(fixedTimestep_);
+			accumulator_ -= fixedTimestep_;
+		}
+		if (accumulator_ >= fixedTimestep_) {
+			// Drop the time not simulated, in order to avoid the spiral of death.
+			spdlog::debug("[sdl::Window] Simulation behind, dropped {} steps", accumulator_ / fixedTimestep_);
+			accumulator_ %= fixedTimestep_;
 		}
 	}
 
@@ -3,20 +3,32 @@
 
 #include "opengl.h"
 #include "color.h"
+#include "framepacer.h"
+#include "latencymonitor.h"
 #include "rect.h"
+#include "statistics.h"
 
 #include <SDL.h>
 
+#include <algorithm>
 #include <chrono>
+#include <span>
 #include <string>
 #include <utility>
 #include <functional>
+#include <vector>
 
 namespace sdl {
 
 	using Clock = std::chrono::high_resolution_clock;
 	using DeltaTime = std::chrono::high_resolution_clock::duration;
 
+	// An SDL event and the time it was generated, i.e. the SDL timestamp mapped to Clock.
+	struct InputEvent {
+		SDL_Event event;
+		Clock::time_point time;
+	};
+
 	// Create a window which handle all user input. The graphic is rendered using OpenGL.
 	class Window {
 	public:
@@ -101,10 +113,68 @@ namespace sdl {
 
 		gl::ClearBufferMask getGlClear() const noexcept;
 		
+		// Sleep a constant time each loop cycle. Prefer the frame pacer, which only waits
+		// the time remaining of the frame.
 		void setLoopSleepingTime(const std::chrono::nanoseconds& delay) noexcept;
 		
 		std::chrono::nanoseconds getLoopSleepingTime() const noexcept;
 
+		// Call simulate() with a fixed time step, as many times as the elapsed time requires
+		// but at most maxSteps each loop cycle, the remaining time is dropped in order to
+		// not fall behind. A zero time step turns it off, which is the default.
+		void setFixedTimestep(const DeltaTime& step, int maxSteps = 5) noexcept;
+
+		const DeltaTime& getFixedTimestep() const noexcept;
+
+		// Return the fraction, in [0, 1), of the time step elapsed since the last call to simulate().
+		// Used in update() to interpolate between the last two simulated states.
+		float getInterpolationAlpha() const noexcept;
+
+		// Set the VSync mode, applied directly if the OpenGL context exists. With the render
+		// thread running, it is applied by the render thread before the next frame.
+		void setVSync(VSync vsync);
+
+		// Return the VSync mode used, may differ from the requested if not supported.
+		VSync getVSync() const noexcept;
+
+		// Render on a separate thread owning the OpenGL context. The main thread handles the
+		// events and calls update(), which must not call OpenGL, while the render thread calls
+		// render() for the previous frame. Use e.g. a TripleBuffer to hand over the frame data.
+		// The clear color, clear mask, VSync and frame pacer settings set in update() are
+		// copied with each frame. Must be set before startLoop().
+		void setRenderThread(bool renderThread) noexcept;
+
+		bool isRenderThread() const noexcept;
+
+		// Measures the latency from input to the frame swapped, turned off by default.
+		LatencyMonitor& getLatencyMonitor() noexcept;
+
+		// Run without showing the window, e.g. for benchmarks on a server. The frames are
+		// rendered into a frame buffer of the window size, nothing is swapped or paced, each
+		// update() is given the same frame time and the loop quits after the number of frames.
+		// Without a display, use SDL's offscreen video driver, see InitSdl. Must be set before
+		// startLoop(), zero frames turns it off.
+		void setHeadless(int frames, const DeltaTime& frameTime = std::chrono::microseconds{16'667});
+
+		bool isHeadless() const noexcept;
+
+		// Save every n:th headless frame as "<filename>_<frame>.png", e.g. for comparing with
+		// golden images. Zero turns it off.
+		void setHeadlessCapture(const std::string& filename, int everyNthFrame = 1);
+
+		// Return the time in milliseconds of each headless frame, glFinish() included.
+		const Statistics& getHeadlessFrameTimes() const noexcept;
+
+		// Controls the target fps, and the fps used when the window is hidden, minimized or not in focus.
+		FramePacer& getFramePacer() noexcept;
+
+		// Merge consecutive SDL_MOUSEMOTION events, from the same mouse and with the same
+		// button state, into one event each frame. The relative motion is summed and the
+		// time of the first event is kept. Default is true.
+		void setCoalesceMouseMotion(bool coalesce) noexcept;
+
+		bool isCoalesceMouseMotion() const noexcept;
+
 		void setHitTestCallback(HitTestCallback onHitTest);
 
 		bool isHitTestCallbackSet() const {
@@ -118,10 +188,29 @@ namespace sdl {
 
 		// Is called each loop cycle.
 		virtual void update(const DeltaTime& deltaTime) {}
+
+		// Is called with the fixed time step before update(), zero or more times each loop
+		// cycle. Only called when a fixed time step is set.
+		virtual void simulate(const DeltaTime& step) {}
 		
 		// Is called each loop cycle until all windowEvents are called.
 		virtual void eventUpdate(const SDL_Event& windowEvent) {}
 
+		// Is called once each loop cycle with all events polled, before update(). Calls
+		// eventUpdate() for each event by default.
+		virtual void eventsUpdate(std::span<const InputEvent> events);
+
+		// Return the events polled this loop cycle, ordered by time.
+		std::span<const InputEvent> getEvents() const noexcept;
+
+		// Is called on the render thread each frame, only when the render thread is used.
+		virtual void render() {}
+
+		// Return false if the subclass must call OpenGL in update(), then the render thread is never used.
+		virtual bool isRenderThreadSupported() const {
+			return true;
+		}
+
 		SDL_GLContext getGlContext();
 
 	private:
@@ -134,11 +223,26 @@ namespace sdl {
 
 		void runLoop();
 
+		void runThreadedLoop();
+
+		void runHeadlessLoop();
+
+		void pollEventsAndUpdate(Clock::time_point& time);
+
+		void pollEventsAndUpdate(const DeltaTime& deltaTime);
+
+		void pollEvents();
+
+		void simulateFixedSteps(const DeltaTime& deltaTime);
+
 		void setupOpenGlContext();
 
+		bool isIdle() const;
+
 		std::string title_;
 
 		HitTestCallback onHitTest_;
+		std::vector<InputEvent> events_;
 		SDL_Window* window_{};
 		SDL_GLContext glContext_{};
 		SDL_Surface* icon_{};
@@ -153,6 +257,20 @@ namespace sdl {
 		int maxHeight_ = -1;
 		
 		std::chrono::nanoseconds sleepingTime_{};
+		DeltaTime fixedTimestep_{};
+		DeltaTime accumulator_{};
+		int maxSteps_ = 5;
+		FramePacer framePacer_;
+		LatencyMonitor latencyMonitor_;
+		Statistics headlessFrameTimes_;
+		std::string captureFilename_;
+		DeltaTime headlessFrameTime_{};
+		int headlessFrames_ = 0;
+		int captureInterval_ = 0;
+		VSync vsync_ = VSync::On;
+		bool renderThread_ = false;
+		bool renderThreadRunning_ = false;
+		bool coalesceMouseMotion_ = true;
 		int majorVersionGl_ = DefaultMajorVersionGl;
 		int minorVersionGl_ = DefaultMinorVersionGl;
 		
@@ -207,6 +325,75 @@ namespace sdl {
 		return sleepingTime_;
 	}
 
+	inline VSync Window::getVSync() const noexcept {
+		return vsync_;
+	}
+
+	inline void Window::setRenderThread(bool renderThread) noexcept {
+		renderThread_ = renderThread;
+	}
+
+	inline bool Window::isRenderThread() const noexcept {
+		return renderThread_;
+	}
+
+	inline void Window::setCoalesceMouseMotion(bool coalesce) noexcept {
+		coalesceMouseMotion_ = coalesce;
+	}
+
+	inline bool Window::isCoalesceMouseMotion() const noexcept {
+		return coalesceMouseMotion_;
+	}
+
+	inline std::span<const InputEvent> Window::getEvents() const noexcept {
+		return events_;
+	}
+
+	inline void Window::setHeadless(int frames, const DeltaTime& frameTime) {
+		headlessFrames_ = frames > 0 ? frames : 0;
+		headlessFrameTime_ = frameTime;
+		// Keep all samples of the run.
+		headlessFrameTimes_ = Statistics{static_cast<std::size_t>(std::max(headlessFrames_, 1))};
+	}
+
+	inline bool Window::isHeadless() const noexcept {
+		return headlessFrames_ > 0;
+	}
+
+	inline void Window::setHeadlessCapture(const std::string& filename, int everyNthFrame) {
+		captureFilename_ = filename;
+		captureInterval_ = everyNthFrame > 0 ? everyNthFrame : 0;
+	}
+
+	inline const Statistics& Window::getHeadlessFrameTimes() const noexcept {
+		return headlessFrameTimes_;
+	}
+
+	inline LatencyMonitor& Window::getLatencyMonitor() noexcept {
+		return latencyMonitor_;
+	}
+
+	inline FramePacer& Window::getFramePacer() noexcept {
+		return framePacer_;
+	}
+
+	inline void Window::setFixedTimestep(const DeltaTime& step, int maxSteps) noexcept {
+		fixedTimestep_ = step > DeltaTime::zero() ? step : DeltaTime::zero();
+		maxSteps_ = maxSteps > 0 ? maxSteps : 1;
+		accumulator_ = DeltaTime::zero();
+	}
+
+	inline const DeltaTime& Window::getFixedTimestep() const noexcept {
+		return fixedTimestep_;
+	}
+
+	inline float Window::getInterpolationAlpha() const noexcept {
+		if (fixedTimestep_ == DeltaTime::zero()) {
+			return 0.f;
+		}
+		return std::chrono::duration<float>(accumulator_) / std::chrono::duration<float>(fixedTimestep_);
+	}
+
 }
 
 #endif